@@ -0,0 +1,118 @@
+/**
+ * @Descripttion: 离散 Fréchet 距离：与完整矩阵动态规划核对，与 Hausdorff 距离比较耗时，判定模式的提前结束
+ * @filename: Frechet距离.c
+ * @Author: 王春博
+ * @Date: 2026.10.19
+ * @Version: V1.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "../common/bench.h"
+#include "../common/rng.h"
+#include "point_set.h"
+#include "hausdorff.h"
+#include "frechet.h"
+
+#define LARGE_POINTS 20000  // 大规模测试的点数
+
+// 完整 n x m 矩阵的动态规划，作为核对；与 frechet_distance 一致，空点集或内存不足返回 -1
+double frechet_full(const PointSet *a, const PointSet *b) {
+    int n = a->count, m = b->count;
+    if (n == 0 || m == 0) return -1.0;
+    double *c = (double *)malloc((size_t)n * m * sizeof(double));
+    if (c == NULL) return -1.0;
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < m; j++) {
+            double d = hypot(a->x[i] - b->x[j], a->y[i] - b->y[j]);
+            double best;
+            if (i == 0 && j == 0) best = 0.0;
+            else if (i == 0) best = c[j - 1];
+            else if (j == 0) best = c[(i - 1) * m];
+            else best = fmin(fmin(c[(i - 1) * m + j], c[i * m + j - 1]), c[(i - 1) * m + j - 1]);
+            c[i * m + j] = fmax(d, best);
+        }
+    }
+    double result = c[(long)n * m - 1];
+    free(c);
+    return result;
+}
+
+int load(const char *path, PointSet *s) {
+    FILE *file = fopen(path, "r");
+    if (file == NULL) {
+        perror(path);
+        return -1;
+    }
+    int status = point_set_read_all(file, s);
+    fclose(file);
+    return status;
+}
+
+void compare(const char *title, const PointSet *a, const PointSet *b, int check) {
+    double t0 = bench_now();
+    double hd = hausdorff_distance_sets(a, b);
+    double t1 = bench_now();
+    double fd = frechet_distance(a, b);
+    double t2 = bench_now();
+    if (fd < 0) {
+        printf("%s：点集为空或内存不足\n", title);
+        return;
+    }
+    int above = frechet_decide(a, b, fd * (1 + 1e-12));
+    double t3 = bench_now();
+    int below = frechet_decide(a, b, hd * 0.99);  // Fréchet 距离不小于 Hausdorff 距离，必为否
+    double t4 = bench_now();
+    printf("%s（%d x %d）\n", title, a->count, b->count);
+    printf("  Hausdorff %.6f（%.2f ms），Fréchet %.6f（%.2f ms）\n", hd, (t1 - t0) * 1e3, fd, (t2 - t1) * 1e3);
+    printf("  判定 eps = Fréchet: %d（%.2f ms），eps = 0.99 Hausdorff: %d（%.3f ms）\n", above, (t3 - t2) * 1e3, below,
+           (t4 - t3) * 1e3);
+    if (check) {
+        double full = frechet_full(a, b);
+        if (full < 0) {
+            printf("  完整矩阵动态规划：内存不足\n");
+        } else {
+            printf("  完整矩阵动态规划: %.6f，差 %.2e\n", full, fabs(full - fd));
+        }
+    }
+}
+
+int main() {
+    PointSet a, b;
+    point_set_init(&a);
+    point_set_init(&b);
+    if (load("BigHomeWork/random_set1.txt", &a) == 0 && load("BigHomeWork/random_set2.txt", &b) == 0) {
+        compare("random_set1 / random_set2", &a, &b, 1);
+    }
+
+    // in.txt 中的两组点
+    FILE *file = fopen("BigHomeWork/in.txt", "r");
+    if (file != NULL) {
+        point_set_clear(&a);
+        point_set_clear(&b);
+        if (point_set_read_counted(file, &a) == 0 && point_set_read_counted(file, &b) == 0) {
+            compare("in.txt", &a, &b, 1);
+        }
+        fclose(file);
+    }
+
+    // 大规模：同一条曲线的两次带噪采样，点数不同
+    point_set_clear(&a);
+    point_set_clear(&b);
+    Rng rng;
+    rng_init(&rng, 2026);
+    for (int i = 0; i < LARGE_POINTS; i++) {
+        double s = 10.0 * i / (LARGE_POINTS - 1);
+        point_set_push(&a, s, sin(s) + rng_uniform_range(&rng, 0.0, 0.01));
+    }
+    for (int i = 0; i < LARGE_POINTS * 3 / 4; i++) {
+        double s = 10.0 * i / (LARGE_POINTS * 3 / 4 - 1);
+        point_set_push(&b, s, sin(s) + rng_uniform_range(&rng, 0.0, 0.01));
+    }
+    compare("带噪正弦曲线", &a, &b, 0);
+
+    point_set_free(&a);
+    point_set_free(&b);
+    return 0;
+}
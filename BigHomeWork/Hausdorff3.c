@@ -1,6 +1,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
+#include "../common/sum.h"
 
 #define MAX_POINTS 1000
 #define LEARNING_RATE 0.01
@@ -20,7 +21,7 @@ double euclidean_distance(Point p1, Point p2) {
 
 // 计算目标函数值
 double objective_function(Point A[], int sizeA, Point B[], int sizeB) {
-    double sum = 0.0;
+    SumAcc sum = sum_acc_init();
     for (int i = 0; i < sizeA; i++) {
         double min_dist = INFINITY;
         for (int j = 0; j < sizeB; j++) {
@@ -29,9 +30,9 @@ double objective_function(Point A[], int sizeA, Point B[], int sizeB) {
                 min_dist = dist;
             }
         }
-        sum += min_dist * min_dist;  // 目标函数是距离的平方
+        sum_acc_add(&sum, min_dist * min_dist);  // 目标函数是距离的平方
     }
-    return sum;
+    return sum_acc_result(sum);
 }
 
 // 计算目标函数的梯度
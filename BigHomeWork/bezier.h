@@ -0,0 +1,215 @@
+/**
+ * @Descripttion: 批量贝塞尔曲线求值：任意次数与维数，Horner 形式的 Bernstein 求值（无 pow），SoA 连续输出，沿参数 t 向量化
+ * @filename: bezier.h
+ * @Author: 王春博
+ * @Date: 2026.10.19
+ * @Version: V1.0
+ *
+ * 控制点按点连续存放：第 i 个控制点的第 d 维为 ctrl[i * dim + d]，次数 degree = 控制点数 - 1。
+ * 求值采用 VS 算法：B(t) = sum C(n,i) (1-t)^(n-i) t^i P_i 按 (1-t) 的嵌套乘法展开，二项式系数逐项递推，
+ * 每个参数点 O(n)，权值全为正数，高次（如 99 次）也不会像幂基转换那样出现抵消。
+ * 同一批的 BEZIER_LANES 个参数点共用外层循环，内层沿参数方向连续，编译器可直接向量化。
+ * 输出为 SoA：第 d 维的 m 个采样点连续存放，out[d * m + k]。C 与 C++ 均可直接包含。
+ * bezier_flatten 按弦高误差自适应细分平面曲线，点直接追加到 PointSet，平直段只留端点。
+ */
+
+#ifndef BEZIER_H
+#define BEZIER_H
+
+#include <stdlib.h>
+#include <string.h>
+#include "point_set.h"
+
+#define BEZIER_LANES 32    // 同时求值的参数点个数（多个向量寄存器交错，掩盖乘加的延迟）
+#define BEZIER_FLATTEN_MAX_DEPTH 24  // 自适应离散化的最大细分深度
+#define BEZIER_BINOM_MAX 128  // 次数不超过此值时二项式系数预先算好，避免内层循环里的除法
+
+// 一批曲线：第 c 条曲线的控制点为 ctrl[offset[c] * dim ..]，次数为 offset[c + 1] - offset[c] - 1
+typedef struct {
+    int count;
+    int dim;
+    const int *offset;
+    const double *ctrl;
+} BezierSet;
+
+// 在 m 个参数点 t[k] 处求值，out 为 dim x m 的 SoA 数组
+static inline void bezier_eval(const double *ctrl, int degree, int dim, const double *t, int m, double *out) {
+    int n = degree;
+    double binom_table[BEZIER_BINOM_MAX];
+    int tabulated = n < BEZIER_BINOM_MAX;
+    if (tabulated) {
+        binom_table[0] = 1.0;
+        for (int i = 1; i < n; i++) binom_table[i] = binom_table[i - 1] * (n - i + 1) / i;
+    }
+    for (int k0 = 0; k0 < m; k0 += BEZIER_LANES) {
+        int lanes = m - k0 < BEZIER_LANES ? m - k0 : BEZIER_LANES;
+        double tl[BEZIER_LANES], sl[BEZIER_LANES];
+        for (int l = 0; l < BEZIER_LANES; l++) {
+            tl[l] = l < lanes ? t[k0 + l] : 0.0;
+            sl[l] = 1.0 - tl[l];
+        }
+        // 各维分别做嵌套乘法，累加器只占一个向量寄存器
+        for (int d = 0; d < dim; d++) {
+            double acc[BEZIER_LANES], tn[BEZIER_LANES];
+            if (n == 0) {
+                for (int l = 0; l < BEZIER_LANES; l++) acc[l] = ctrl[d];
+            } else {
+                // acc = P_0 (1-t)
+                for (int l = 0; l < BEZIER_LANES; l++) {
+                    acc[l] = ctrl[d] * sl[l];
+                    tn[l] = tl[l];
+                }
+                // acc = (acc + C(n,i) t^i P_i) (1-t)，i = 1 .. n-1
+                double binom = 1.0;
+                for (int i = 1; i < n; i++) {
+                    binom = tabulated ? binom_table[i] : binom * (n - i + 1) / i;
+                    double p = binom * ctrl[(long) i * dim + d];
+                    for (int l = 0; l < BEZIER_LANES; l++) {
+                        acc[l] = (acc[l] + tn[l] * p) * sl[l];
+                        tn[l] *= tl[l];
+                    }
+                }
+                // acc += t^n P_n
+                double p = ctrl[(long) n * dim + d];
+                for (int l = 0; l < BEZIER_LANES; l++) acc[l] += tn[l] * p;
+            }
+            double *o = out + (long) d * m + k0;
+            if (lanes == BEZIER_LANES) {
+                for (int l = 0; l < BEZIER_LANES; l++) o[l] = acc[l];
+            } else {
+                for (int l = 0; l < lanes; l++) o[l] = acc[l];
+            }
+        }
+    }
+}
+
+// de Casteljau 算法求单点，同时给出在 t 处细分得到的左右两段控制点（left/right 可为 NULL）
+// work 至少 (degree + 1) * dim 个元素；O(n^2)，用于细分而不是批量求值
+static inline void bezier_de_casteljau(const double *ctrl, int degree, int dim, double t,
+                                       double *point, double *left, double *right, double *work) {
+    int n = degree;
+    memcpy(work, ctrl, (size_t) (n + 1) * dim * sizeof(double));
+    for (int d = 0; d < dim; d++) {
+        if (left != NULL) left[d] = work[d];
+        if (right != NULL) right[(long) n * dim + d] = work[(long) n * dim + d];
+    }
+    for (int r = 1; r <= n; r++) {
+        for (int i = 0; i <= n - r; i++) {
+            for (int d = 0; d < dim; d++) {
+                double *w = work + (long) i * dim + d;
+                *w += t * (w[dim] - *w);
+            }
+        }
+        for (int d = 0; d < dim; d++) {
+            if (left != NULL) left[(long) r * dim + d] = work[d];
+            if (right != NULL) right[(long) (n - r) * dim + d] = work[(long) (n - r) * dim + d];
+        }
+    }
+    for (int d = 0; d < dim; d++) point[d] = work[d];
+}
+
+// 每条曲线在 [0, 1] 上均匀采样 samples 个点，第 c 条曲线写入 out + c * dim * samples（SoA）
+// 各曲线互不相关，按曲线并行；成功返回 0，内存不足返回 -1
+static inline int bezier_sample_uniform(const BezierSet *set, int samples, double *out) {
+    double *t = (double *) malloc((size_t) (samples > 0 ? samples : 1) * sizeof(double));
+    if (t == NULL) return -1;
+    for (int k = 0; k < samples; k++) t[k] = samples > 1 ? (double) k / (samples - 1) : 0.0;
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (int c = 0; c < set->count; c++) {
+        int degree = set->offset[c + 1] - set->offset[c] - 1;
+        bezier_eval(set->ctrl + (long) set->offset[c] * set->dim, degree, set->dim, t, samples,
+                    out + (long) c * set->dim * samples);
+    }
+    free(t);
+    return 0;
+}
+
+// 单条平面曲线均匀采样 samples 个点，覆盖写入点集 out；成功返回 0，内存不足返回 -1
+static inline int bezier_sample_points(const double *ctrl, int degree, int samples, PointSet *out) {
+    double *soa = (double *) malloc((size_t) (samples > 0 ? samples : 1) * 2 * sizeof(double));
+    int offset[2] = {0, degree + 1};
+    BezierSet set = {1, 2, offset, ctrl};
+    point_set_clear(out);
+    if (soa == NULL || point_set_reserve(out, samples) != 0 || bezier_sample_uniform(&set, samples, soa) != 0) {
+        free(soa);
+        return -1;
+    }
+    for (int k = 0; k < samples; k++) {
+        out->x[k] = soa[k];
+        out->y[k] = soa[samples + k];
+    }
+    out->count = samples;
+    free(soa);
+    return 0;
+}
+
+// 从文本文件读取至多 max_points 个平面控制点（每行 "x y"），交错写入 ctrl；
+// 返回读到的点数，文件打不开返回 -1（errno 保留，由调用方报告）
+static inline int bezier_read_control_points(const char *path, double *ctrl, int max_points) {
+    FILE *file = fopen(path, "r");
+    if (file == NULL) return -1;
+    int count = 0;
+    while (count < max_points && fscanf(file, "%lf %lf", &ctrl[count * 2], &ctrl[count * 2 + 1]) == 2) {
+        count++;
+    }
+    fclose(file);
+    return count;
+}
+
+// 点 (px, py) 到线段 (ax, ay)-(bx, by) 的平方距离
+static inline double bezier_segment_dist_sq(double px, double py, double ax, double ay, double bx, double by) {
+    double ux = bx - ax, uy = by - ay, wx = px - ax, wy = py - ay;
+    double len_sq = ux * ux + uy * uy;
+    double s = len_sq > 0.0 ? (wx * ux + wy * uy) / len_sq : 0.0;
+    s = s < 0.0 ? 0.0 : (s > 1.0 ? 1.0 : s);
+    double dx = wx - s * ux, dy = wy - s * uy;
+    return dx * dx + dy * dy;
+}
+
+// 自适应离散化平面贝塞尔曲线：控制点到弦的距离都不超过 tol 时，由凸包性质整段曲线离弦不超过 tol，
+// 用弦代替；否则在 t = 0.5 处细分。起点在 out 为空时写入，之后按顺序追加各段终点。
+// 多条曲线首尾相接时可连续调用同一个 out。成功返回 0，内存不足返回 -1
+static inline int bezier_flatten(const double *ctrl, int degree, double tol, PointSet *out) {
+    int n = degree, len = (n + 1) * 2;
+    // 显式栈：先处理左半段，右半段压栈；深度受限，栈中最多 BEZIER_FLATTEN_MAX_DEPTH + 1 段，另留两段作细分的临时区
+    double *stack = (double *) malloc((size_t) (BEZIER_FLATTEN_MAX_DEPTH + 3) * len * sizeof(double));
+    int *depth = (int *) malloc((BEZIER_FLATTEN_MAX_DEPTH + 2) * sizeof(int));
+    if (stack == NULL || depth == NULL) {
+        free(stack);
+        free(depth);
+        return -1;
+    }
+    double *work = stack + (long) (BEZIER_FLATTEN_MAX_DEPTH + 2) * len;
+    double tol_sq = tol * tol, mid[2];
+    int status = 0;
+    if (out->count == 0) status = point_set_push(out, ctrl[0], ctrl[1]);
+    memcpy(stack, ctrl, (size_t) len * sizeof(double));
+    depth[0] = 0;
+    int top = 1;
+    while (top > 0 && status == 0) {
+        top--;
+        double *p = stack + (long) top * len;
+        double ax = p[0], ay = p[1], bx = p[2 * n], by = p[2 * n + 1];
+        int flat = 1;
+        for (int i = 1; i < n && flat; i++) {
+            flat = bezier_segment_dist_sq(p[2 * i], p[2 * i + 1], ax, ay, bx, by) <= tol_sq;
+        }
+        if (flat || depth[top] >= BEZIER_FLATTEN_MAX_DEPTH) {
+            status = point_set_push(out, bx, by);
+            continue;
+        }
+        // 右半段放回当前位置、左半段放到上面一层，先弹出左半段
+        int d = depth[top] + 1;
+        bezier_de_casteljau(p, n, 2, 0.5, mid, work, p + len, p + 2 * len);
+        memcpy(p, p + len, (size_t) len * sizeof(double));
+        memcpy(p + len, work, (size_t) len * sizeof(double));
+        depth[top] = d;
+        depth[top + 1] = d;
+        top += 2;
+    }
+    free(stack);
+    free(depth);
+    return status;
+}
+
+#endif // BEZIER_H
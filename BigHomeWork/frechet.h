@@ -0,0 +1,128 @@
+/**
+ * @Descripttion: 离散 Fréchet 距离：按反对角线推进的动态规划，线性内存，反对角线内并行；判定模式可提前结束
+ * @filename: frechet.h
+ * @Author: 王春博
+ * @Date: 2026.10.19
+ * @Version: V1.0
+ *
+ * 递推 c(i, j) = max(d(a_i, b_j), min(c(i-1, j), c(i-1, j-1), c(i, j-1)))，结果为 c(n-1, m-1)。
+ * 第 k 条反对角线（i + j = k）只依赖第 k-1、k-2 条，同一条线上的格子互不依赖：
+ * 只保留三条反对角线，按 i 下标存放，内存 O(min(n, m))；线上各格并行、向量化。
+ * 判定模式只回答“距离是否不超过 eps”，格子只记可达与否，每条反对角线只扫描可达窄带，相邻两条都不可达时立即返回。
+ * 与 Hausdorff 不同，Fréchet 距离要求两条曲线的点按顺序对应，点集顺序有意义。
+ */
+
+#ifndef FRECHET_H
+#define FRECHET_H
+
+#include <stdlib.h>
+#include <math.h>
+#include "point_set.h"
+
+#define FRECHET_PARALLEL_MIN 2048  // 反对角线长度不少于此值时才并行
+
+// 离散 Fréchet 距离，任一曲线为空或内存不足时返回 -1
+static inline double frechet_distance(const PointSet *a, const PointSet *b) {
+    // 距离对称，按短曲线下标存放，内存为较短曲线的长度
+    if (a->count > b->count) {
+        const PointSet *t = a;
+        a = b;
+        b = t;
+    }
+    int n = a->count, m = b->count;
+    if (n == 0) return -1.0;
+    double *buffer = (double *) malloc((size_t) 3 * n * sizeof(double));
+    if (buffer == NULL) return -1.0;
+    double *prev2 = buffer, *prev = buffer + n, *cur = buffer + 2 * n;
+    const double *ax = a->x, *ay = a->y, *bx = b->x, *by = b->y;
+    for (int k = 0; k < n + m - 1; k++) {
+        int lo = k - m + 1 > 0 ? k - m + 1 : 0, hi = k < n - 1 ? k : n - 1;
+        #pragma omp parallel for simd schedule(static) if (hi - lo + 1 >= FRECHET_PARALLEL_MIN)
+        for (int i = lo; i <= hi; i++) {
+            int j = k - i;
+            double dx = ax[i] - bx[j], dy = ay[i] - by[j];
+            double d = dx * dx + dy * dy;
+            // 越界的前驱记为无穷大；(i, j-1) 在 j = 0 时不在第 k-1 条线上，该位置是旧数据
+            double up = i > 0 ? prev[i - 1] : INFINITY;
+            double left = j > 0 ? prev[i] : INFINITY;
+            double diag = i > 0 && j > 0 ? prev2[i - 1] : INFINITY;
+            double best = up < left ? up : left;
+            best = diag < best ? diag : best;
+            best = k == 0 ? 0.0 : best;
+            cur[i] = d > best ? d : best;
+        }
+        double *t = prev2;
+        prev2 = prev;
+        prev = cur;
+        cur = t;
+    }
+    double result = sqrt(prev[n - 1]);
+    free(buffer);
+    return result;
+}
+
+// 判定离散 Fréchet 距离是否不超过 eps：是返回 1，否返回 0，任一曲线为空或内存不足返回 -1
+static inline int frechet_decide(const PointSet *a, const PointSet *b, double eps) {
+    if (a->count > b->count) {
+        const PointSet *t = a;
+        a = b;
+        b = t;
+    }
+    int n = a->count, m = b->count;
+    if (n == 0) return -1;
+    const double *ax = a->x, *ay = a->y, *bx = b->x, *by = b->y;
+    double eps_sq = eps * eps;
+    // 两端点必须互相对应，先检查
+    double sx = ax[0] - bx[0], sy = ay[0] - by[0], ex = ax[n - 1] - bx[m - 1], ey = ay[n - 1] - by[m - 1];
+    if (sx * sx + sy * sy > eps_sq || ex * ex + ey * ey > eps_sq) return 0;
+    unsigned char *buffer = (unsigned char *) malloc((size_t) 3 * n);
+    if (buffer == NULL) return -1;
+    unsigned char *prev2 = buffer, *prev = buffer + n, *cur = buffer + 2 * n;
+    // [lo1, hi1]、[lo2, hi2] 为前两条反对角线上可达格子的下标范围，范围外一律视为不可达（不读旧数据）；
+    // 本条线只需扫描能由它们到达的范围，曲线对应良好时只是对角线附近的一条窄带
+    int lo1 = 0, hi1 = -1, lo2 = 0, hi2 = -1;
+    int result = 1;
+    for (int k = 0; k < n + m - 1; k++) {
+        int lo = k - m + 1 > 0 ? k - m + 1 : 0, hi = k < n - 1 ? k : n - 1;
+        if (k > 0) {
+            int from = lo1, to = hi1 + 1;
+            if (hi2 >= lo2) {
+                from = lo2 + 1 < from ? lo2 + 1 : from;
+                to = hi2 + 1 > to ? hi2 + 1 : to;
+            }
+            lo = from > lo ? from : lo;
+            hi = to < hi ? to : hi;
+        }
+        int rlo = n, rhi = -1;
+        #pragma omp parallel for simd schedule(static) reduction(min:rlo) reduction(max:rhi) if (hi - lo + 1 >= FRECHET_PARALLEL_MIN)
+        for (int i = lo; i <= hi; i++) {
+            int j = k - i;
+            double dx = ax[i] - bx[j], dy = ay[i] - by[j];
+            int up = i - 1 >= lo1 && i - 1 <= hi1 && prev[i - 1];
+            int left = j > 0 && i >= lo1 && i <= hi1 && prev[i];
+            int diag = j > 0 && i - 1 >= lo2 && i - 1 <= hi2 && prev2[i - 1];
+            int reach = (k == 0 || up || left || diag) && dx * dx + dy * dy <= eps_sq;
+            cur[i] = (unsigned char) reach;
+            rlo = reach && i < rlo ? i : rlo;
+            rhi = reach && i > rhi ? i : rhi;
+        }
+        // 斜向一步跨过一条反对角线，相邻两条都不可达时终点才不可能到达
+        if (rhi < 0 && hi1 < lo1) {
+            result = 0;
+            break;
+        }
+        unsigned char *t = prev2;
+        prev2 = prev;
+        prev = cur;
+        cur = t;
+        lo2 = lo1;
+        hi2 = hi1;
+        lo1 = rlo;
+        hi1 = rhi;
+    }
+    if (result == 1) result = hi1 == n - 1;  // 最后一条反对角线只有终点一格
+    free(buffer);
+    return result;
+}
+
+#endif // FRECHET_H
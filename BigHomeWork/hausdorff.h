@@ -0,0 +1,96 @@
+/**
+ * @Descripttion: 点集 Hausdorff 距离：SoA 分块向量化 + 早停，按外层点并行
+ * @filename: hausdorff.h
+ * @Author: 王春博
+ * @Date: 2026.10.19
+ * @Version: V1.0
+ *
+ * 单向距离 h(A, B) = max_a min_b |a - b|。对每个 a 分块扫描 B，块内求最小平方距离可向量化；
+ * 一旦当前最小值不超过已知的最大值，这个 a 不可能再抬高结果，直接跳出（早停）。
+ * 自适应离散化得到的点稀疏而不均匀，顶点之间的距离不能代表曲线之间的距离，
+ * 此时把点集看作折线，量顶点到对方折线（线段）的距离。这只考虑了顶点，最远点落在线段内部时会低估，
+ * 结果是折线间 Hausdorff 距离的下界；需要精确值时用 segment_hausdorff.h。
+ */
+
+#ifndef HAUSDORFF_H
+#define HAUSDORFF_H
+
+#include <math.h>
+#include "point_set.h"
+
+#define HAUSDORFF_BLOCK 64  // 早停检查的分块长度
+
+// 单向 Hausdorff 距离的平方
+static inline double hausdorff_directed_sq(const PointSet *a, const PointSet *b) {
+    double cmax = 0.0;
+    if (b->count == 0) return a->count > 0 ? INFINITY : 0.0;
+    const double *bx = b->x, *by = b->y;
+    int nb = b->count;
+    // 各线程的 cmax 都是最终结果的下界，用它早停是安全的
+    #pragma omp parallel for schedule(dynamic, 64) reduction(max:cmax)
+    for (int i = 0; i < a->count; i++) {
+        double px = a->x[i], py = a->y[i];
+        double cmin = INFINITY;
+        for (int j0 = 0; j0 < nb; j0 += HAUSDORFF_BLOCK) {
+            int j1 = j0 + HAUSDORFF_BLOCK < nb ? j0 + HAUSDORFF_BLOCK : nb;
+            double m = INFINITY;
+            #pragma omp simd reduction(min:m)
+            for (int j = j0; j < j1; j++) {
+                double dx = bx[j] - px, dy = by[j] - py;
+                double d = dx * dx + dy * dy;
+                m = d < m ? d : m;
+            }
+            if (m < cmin) cmin = m;
+            if (cmin <= cmax) break;  // 早停
+        }
+        if (cmin > cmax) cmax = cmin;
+    }
+    return cmax;
+}
+
+// 点集 a 到折线 b（顶点按顺序相连）的单向距离平方，b 只有一个点时退化为点距离
+static inline double hausdorff_points_to_polyline_sq(const PointSet *a, const PointSet *b) {
+    if (b->count < 2) return hausdorff_directed_sq(a, b);
+    double cmax = 0.0;
+    const double *bx = b->x, *by = b->y;
+    int segments = b->count - 1;
+    #pragma omp parallel for schedule(dynamic, 64) reduction(max:cmax)
+    for (int i = 0; i < a->count; i++) {
+        double px = a->x[i], py = a->y[i];
+        double cmin = INFINITY;
+        for (int j0 = 0; j0 < segments; j0 += HAUSDORFF_BLOCK) {
+            int j1 = j0 + HAUSDORFF_BLOCK < segments ? j0 + HAUSDORFF_BLOCK : segments;
+            double m = INFINITY;
+            #pragma omp simd reduction(min:m)
+            for (int j = j0; j < j1; j++) {
+                double ux = bx[j + 1] - bx[j], uy = by[j + 1] - by[j];
+                double wx = px - bx[j], wy = py - by[j];
+                double len_sq = ux * ux + uy * uy;
+                double t = len_sq > 0.0 ? (wx * ux + wy * uy) / len_sq : 0.0;
+                t = t < 0.0 ? 0.0 : (t > 1.0 ? 1.0 : t);
+                double dx = wx - t * ux, dy = wy - t * uy;
+                double d = dx * dx + dy * dy;
+                m = d < m ? d : m;
+            }
+            if (m < cmin) cmin = m;
+            if (cmin <= cmax) break;
+        }
+        if (cmin > cmax) cmax = cmin;
+    }
+    return cmax;
+}
+
+// 两条折线顶点到对方折线的双向距离，适合自适应离散化的结果。
+// 只取顶点、不取线段内部的点，是两条折线 Hausdorff 距离的下界（如三角形两种连法的例子，见 精确曲线距离.c）
+static inline double hausdorff_distance_polylines(const PointSet *a, const PointSet *b) {
+    double ab = hausdorff_points_to_polyline_sq(a, b), ba = hausdorff_points_to_polyline_sq(b, a);
+    return sqrt(ab > ba ? ab : ba);
+}
+
+// 双向 Hausdorff 距离
+static inline double hausdorff_distance_sets(const PointSet *a, const PointSet *b) {
+    double ab = hausdorff_directed_sq(a, b), ba = hausdorff_directed_sq(b, a);
+    return sqrt(ab > ba ? ab : ba);
+}
+
+#endif // HAUSDORFF_H
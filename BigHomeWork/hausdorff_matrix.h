@@ -0,0 +1,339 @@
+/**
+ * @Descripttion: 曲线库的全对 Hausdorff 距离矩阵：每个点集只建一次索引，包围盒下界剪枝，按缓存分块调度
+ * @filename: hausdorff_matrix.h
+ * @Author: 王春博
+ * @Date: 2026.10.19
+ * @Version: V1.0
+ *
+ * 索引：点按 Morton 序重排后每 HAUSDORFF_INDEX_BLOCK 个一块，记录每块的包围盒。求 a 到 b 的单向距离时，
+ * 先用 a 的稀疏抽样点抬高已知最大值，再逐块处理其余点：整块都不可能抬高最大值的 a 块跳过，
+ * 每个点从上一点的最近块开始扫描 b，离当前最小值更远的 b 块跳过，最小值不超过已知最大值时早停。
+ * 下界：A 中 x 最小的点到 B 的距离不小于 B.min_x - A.min_x，反之亦然，故 H(A, B) 不小于两包围盒
+ * 四条边坐标差的最大值；阈值模式下大于阈值的对直接剪掉，不算距离；其余的对以它作为早停的初始最大值。
+ * 调度：K x K 的上三角按 HAUSDORFF_TILE x HAUSDORFF_TILE 分块，一块内的点集在缓存中反复使用，块之间动态分配给线程。
+ */
+
+#ifndef HAUSDORFF_MATRIX_H
+#define HAUSDORFF_MATRIX_H
+
+#include <stdlib.h>
+#include <math.h>
+#include "point_set.h"
+
+#define HAUSDORFF_INDEX_BLOCK 16  // 索引中每块的点数
+#define HAUSDORFF_TILE 16         // 调度块的边长（点集个数）
+#define HAUSDORFF_STRIDE 16       // 单向距离先处理的抽样点步长
+
+// 一个点集的索引：块 k 的点为 x/y[k * HAUSDORFF_INDEX_BLOCK ..]，包围盒为 box[4k .. 4k+3]（min_x, min_y, max_x, max_y）
+typedef struct {
+    int count;
+    int blocks;
+    double *x, *y;
+    double *box;
+    double min_x, min_y, max_x, max_y;
+} HausdorffIndex;
+
+// 稀疏结果：距离不超过阈值的对 (i, j)，i < j，按 i、j 排序
+typedef struct {
+    long count;
+    long capacity;
+    int *i, *j;
+    double *dist;
+    long pruned;  // 被包围盒下界剪掉的对数
+} HausdorffPairs;
+
+static inline void hausdorff_index_free(HausdorffIndex *h) {
+    free(h->x);
+    free(h->y);
+    free(h->box);
+    h->x = h->y = h->box = NULL;
+}
+
+// 16 位坐标交错成 32 位 Morton 码
+static inline unsigned hausdorff_morton(unsigned x, unsigned y) {
+    unsigned code = 0;
+    for (int bit = 0; bit < 16; bit++) code |= ((x >> bit & 1u) << (2 * bit)) | ((y >> bit & 1u) << (2 * bit + 1));
+    return code;
+}
+
+static inline int hausdorff_key_compare(const void *p, const void *q) {
+    unsigned long long a = *(const unsigned long long *) p, b = *(const unsigned long long *) q;
+    return a < b ? -1 : (a > b ? 1 : 0);
+}
+
+// 建立索引，成功返回 0，内存不足返回 -1
+static inline int hausdorff_index_build(HausdorffIndex *h, const PointSet *s) {
+    int n = s->count;
+    h->count = n;
+    h->blocks = (n + HAUSDORFF_INDEX_BLOCK - 1) / HAUSDORFF_INDEX_BLOCK;
+    h->x = (double *) malloc((size_t) (n > 0 ? n : 1) * sizeof(double));
+    h->y = (double *) malloc((size_t) (n > 0 ? n : 1) * sizeof(double));
+    h->box = (double *) malloc((size_t) (h->blocks > 0 ? h->blocks : 1) * 4 * sizeof(double));
+    unsigned long long *key = (unsigned long long *) malloc((size_t) (n > 0 ? n : 1) * sizeof(unsigned long long));
+    if (h->x == NULL || h->y == NULL || h->box == NULL || key == NULL) {
+        free(key);
+        hausdorff_index_free(h);
+        return -1;
+    }
+    h->min_x = h->min_y = INFINITY;
+    h->max_x = h->max_y = -INFINITY;
+    for (int i = 0; i < n; i++) {
+        h->min_x = s->x[i] < h->min_x ? s->x[i] : h->min_x;
+        h->min_y = s->y[i] < h->min_y ? s->y[i] : h->min_y;
+        h->max_x = s->x[i] > h->max_x ? s->x[i] : h->max_x;
+        h->max_y = s->y[i] > h->max_y ? s->y[i] : h->max_y;
+    }
+    // 高 32 位为 Morton 码、低 32 位为原下标，一次排序得到重排顺序
+    double sx = h->max_x > h->min_x ? 65535.0 / (h->max_x - h->min_x) : 0.0;
+    double sy = h->max_y > h->min_y ? 65535.0 / (h->max_y - h->min_y) : 0.0;
+    for (int i = 0; i < n; i++) {
+        unsigned qx = (unsigned) ((s->x[i] - h->min_x) * sx), qy = (unsigned) ((s->y[i] - h->min_y) * sy);
+        key[i] = (unsigned long long) hausdorff_morton(qx, qy) << 32 | (unsigned) i;
+    }
+    qsort(key, (size_t) n, sizeof(unsigned long long), hausdorff_key_compare);
+    for (int i = 0; i < n; i++) {
+        int src = (int) (key[i] & 0xffffffffu);
+        h->x[i] = s->x[src];
+        h->y[i] = s->y[src];
+    }
+    free(key);
+    for (int k = 0; k < h->blocks; k++) {
+        int lo = k * HAUSDORFF_INDEX_BLOCK, hi = lo + HAUSDORFF_INDEX_BLOCK < n ? lo + HAUSDORFF_INDEX_BLOCK : n;
+        double *b = h->box + 4 * k;
+        b[0] = b[1] = INFINITY;
+        b[2] = b[3] = -INFINITY;
+        for (int i = lo; i < hi; i++) {
+            b[0] = h->x[i] < b[0] ? h->x[i] : b[0];
+            b[1] = h->y[i] < b[1] ? h->y[i] : b[1];
+            b[2] = h->x[i] > b[2] ? h->x[i] : b[2];
+            b[3] = h->y[i] > b[3] ? h->y[i] : b[3];
+        }
+    }
+    return 0;
+}
+
+// 包围盒给出的 Hausdorff 距离下界
+static inline double hausdorff_index_lower_bound(const HausdorffIndex *a, const HausdorffIndex *b) {
+    double d = fabs(a->min_x - b->min_x), t;
+    t = fabs(a->min_y - b->min_y);
+    d = t > d ? t : d;
+    t = fabs(a->max_x - b->max_x);
+    d = t > d ? t : d;
+    t = fabs(a->max_y - b->max_y);
+    return t > d ? t : d;
+}
+
+// 块 k 中离 (px, py) 最近点的平方距离
+static inline double hausdorff_block_min_sq(const HausdorffIndex *b, int k, double px, double py) {
+    int lo = k * HAUSDORFF_INDEX_BLOCK, hi = lo + HAUSDORFF_INDEX_BLOCK < b->count ? lo + HAUSDORFF_INDEX_BLOCK : b->count;
+    const double *bx = b->x, *by = b->y;
+    double m = INFINITY;
+    #pragma omp simd reduction(min:m)
+    for (int j = lo; j < hi; j++) {
+        double dx = bx[j] - px, dy = by[j] - py;
+        double d = dx * dx + dy * dy;
+        m = d < m ? d : m;
+    }
+    return m;
+}
+
+// 点 (px, py) 到 b 的最近平方距离，不超过 stop_sq 即可提前返回；*hint 为上一次的最近块，先扫它得到较小的初值
+static inline double hausdorff_index_point_sq(const HausdorffIndex *b, double px, double py, double stop_sq, int *hint) {
+    double cmin = hausdorff_block_min_sq(b, *hint, px, py);
+    for (int k = 0; k < b->blocks && cmin > stop_sq; k++) {
+        if (k == *hint) continue;
+        const double *bb = b->box + 4 * k;
+        double dx = px < bb[0] ? bb[0] - px : (px > bb[2] ? px - bb[2] : 0.0);
+        double dy = py < bb[1] ? bb[1] - py : (py > bb[3] ? py - bb[3] : 0.0);
+        if (dx * dx + dy * dy >= cmin) continue;
+        double m = hausdorff_block_min_sq(b, k, px, py);
+        if (m < cmin) {
+            cmin = m;
+            *hint = k;
+        }
+    }
+    return cmin;
+}
+
+// max(lower_sq, 单向距离的平方)：已知 Hausdorff 距离的下界时，最近距离不超过它的点都不必算完，早停更早；
+// 超过 limit_sq 后立即返回（此时返回值只保证大于 limit_sq）
+static inline double hausdorff_index_directed_sq(const HausdorffIndex *a, const HausdorffIndex *b, double lower_sq,
+                                                 double limit_sq) {
+    if (b->count == 0) return a->count > 0 ? INFINITY : lower_sq;
+    double cmax = lower_sq;
+    int hint = 0;
+    // 先按步长 HAUSDORFF_STRIDE 抽样，抽样点分散在整个点集上，cmax 很快接近最终值
+    for (int i = 0; i < a->count; i += HAUSDORFF_STRIDE) {
+        double cmin = hausdorff_index_point_sq(b, a->x[i], a->y[i], cmax, &hint);
+        if (cmin > cmax) {
+            cmax = cmin;
+            if (cmax > limit_sq) return cmax;
+        }
+    }
+    // 再逐块处理其余点：若 b 的某一点到 a 块包围盒最远角的距离不超过 cmax，块内的点都不可能抬高 cmax，整块跳过；
+    // 块内按 Morton 序，相邻点的最近块多半相同，大多扫完一块即可早停
+    for (int ka = 0; ka < a->blocks; ka++) {
+        const double *ab = a->box + 4 * ka;
+        double qx = b->x[hint * HAUSDORFF_INDEX_BLOCK], qy = b->y[hint * HAUSDORFF_INDEX_BLOCK];
+        double fx = fmax(qx - ab[0], ab[2] - qx), fy = fmax(qy - ab[1], ab[3] - qy);
+        if (fx * fx + fy * fy <= cmax) continue;
+        int lo = ka * HAUSDORFF_INDEX_BLOCK, hi = lo + HAUSDORFF_INDEX_BLOCK < a->count ? lo + HAUSDORFF_INDEX_BLOCK : a->count;
+        for (int i = lo; i < hi; i++) {
+            if (i % HAUSDORFF_STRIDE == 0) continue;
+            double cmin = hausdorff_index_point_sq(b, a->x[i], a->y[i], cmax, &hint);
+            if (cmin > cmax) {
+                cmax = cmin;
+                if (cmax > limit_sq) return cmax;
+            }
+        }
+    }
+    return cmax;
+}
+
+// 两个索引之间的 Hausdorff 距离；大于 limit 时返回值只保证大于 limit（limit 取 INFINITY 为精确值）
+static inline double hausdorff_index_distance(const HausdorffIndex *a, const HausdorffIndex *b, double limit) {
+    double lb = hausdorff_index_lower_bound(a, b);
+    if (lb > limit) return lb;
+    // 包围盒下界作为 a -> b 的起点，a -> b 的结果再作为 b -> a 的起点
+    double limit_sq = limit * limit;
+    double ab = hausdorff_index_directed_sq(a, b, lb * lb, limit_sq);
+    if (ab > limit_sq) return sqrt(ab);
+    return sqrt(hausdorff_index_directed_sq(b, a, ab, limit_sq));
+}
+
+static inline HausdorffIndex *hausdorff_index_build_all(const PointSet *sets, int count) {
+    HausdorffIndex *index = (HausdorffIndex *) calloc((size_t) (count > 0 ? count : 1), sizeof(HausdorffIndex));
+    if (index == NULL) return NULL;
+    int failed = 0;
+    #pragma omp parallel for schedule(dynamic, 8) reduction(|:failed)
+    for (int c = 0; c < count; c++) failed |= hausdorff_index_build(&index[c], &sets[c]) != 0;
+    if (failed) {
+        for (int c = 0; c < count; c++) hausdorff_index_free(&index[c]);
+        free(index);
+        return NULL;
+    }
+    return index;
+}
+
+static inline void hausdorff_index_free_all(HausdorffIndex *index, int count) {
+    for (int c = 0; c < count; c++) hausdorff_index_free(&index[c]);
+    free(index);
+}
+
+// 稠密距离矩阵 out[i * count + j]（对称，对角为 0），成功返回 0，内存不足返回 -1
+static inline int hausdorff_matrix_dense(const PointSet *sets, int count, double *out) {
+    HausdorffIndex *index = hausdorff_index_build_all(sets, count);
+    if (index == NULL) return -1;
+    int tiles = (count + HAUSDORFF_TILE - 1) / HAUSDORFF_TILE;
+    // 上三角分块 (ti, tj)，ti <= tj，线性编号后动态调度
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (long t = 0; t < (long) tiles * tiles; t++) {
+        int ti = (int) (t / tiles), tj = (int) (t % tiles);
+        if (ti > tj) continue;
+        int i1 = (ti + 1) * HAUSDORFF_TILE < count ? (ti + 1) * HAUSDORFF_TILE : count;
+        int j1 = (tj + 1) * HAUSDORFF_TILE < count ? (tj + 1) * HAUSDORFF_TILE : count;
+        for (int i = ti * HAUSDORFF_TILE; i < i1; i++) {
+            for (int j = ti == tj ? i + 1 : tj * HAUSDORFF_TILE; j < j1; j++) {
+                double d = hausdorff_index_distance(&index[i], &index[j], INFINITY);
+                out[(long) i * count + j] = d;
+                out[(long) j * count + i] = d;
+            }
+            out[(long) i * count + i] = 0.0;
+        }
+    }
+    hausdorff_index_free_all(index, count);
+    return 0;
+}
+
+static inline void hausdorff_pairs_init(HausdorffPairs *p) {
+    p->count = p->capacity = p->pruned = 0;
+    p->i = p->j = NULL;
+    p->dist = NULL;
+}
+
+static inline void hausdorff_pairs_free(HausdorffPairs *p) {
+    free(p->i);
+    free(p->j);
+    free(p->dist);
+    hausdorff_pairs_init(p);
+}
+
+static inline int hausdorff_pairs_push(HausdorffPairs *p, int i, int j, double dist) {
+    if (p->count == p->capacity) {
+        long capacity = p->capacity > 0 ? 2 * p->capacity : 256;
+        int *ni = (int *) realloc(p->i, (size_t) capacity * sizeof(int));
+        if (ni == NULL) return -1;
+        p->i = ni;
+        int *nj = (int *) realloc(p->j, (size_t) capacity * sizeof(int));
+        if (nj == NULL) return -1;
+        p->j = nj;
+        double *nd = (double *) realloc(p->dist, (size_t) capacity * sizeof(double));
+        if (nd == NULL) return -1;
+        p->dist = nd;
+        p->capacity = capacity;
+    }
+    p->i[p->count] = i;
+    p->j[p->count] = j;
+    p->dist[p->count] = dist;
+    p->count++;
+    return 0;
+}
+
+// 阈值稀疏矩阵：距离不超过 threshold 的对追加到 out（out 需先初始化），成功返回 0，内存不足返回 -1
+// 结果按 (i, j) 排序，与线程数无关
+static inline int hausdorff_matrix_sparse(const PointSet *sets, int count, double threshold, HausdorffPairs *out) {
+    HausdorffIndex *index = hausdorff_index_build_all(sets, count);
+    if (index == NULL) return -1;
+    int tiles = (count + HAUSDORFF_TILE - 1) / HAUSDORFF_TILE;
+    long total = (long) tiles * tiles;
+    HausdorffPairs *local = (HausdorffPairs *) malloc((size_t) (total > 0 ? total : 1) * sizeof(HausdorffPairs));
+    if (local == NULL) {
+        hausdorff_index_free_all(index, count);
+        return -1;
+    }
+    int failed = 0;
+    #pragma omp parallel for schedule(dynamic, 1) reduction(|:failed)
+    for (long t = 0; t < total; t++) {
+        HausdorffPairs *p = &local[t];
+        hausdorff_pairs_init(p);
+        int ti = (int) (t / tiles), tj = (int) (t % tiles);
+        if (ti > tj) continue;
+        int i1 = (ti + 1) * HAUSDORFF_TILE < count ? (ti + 1) * HAUSDORFF_TILE : count;
+        int j1 = (tj + 1) * HAUSDORFF_TILE < count ? (tj + 1) * HAUSDORFF_TILE : count;
+        for (int i = ti * HAUSDORFF_TILE; i < i1; i++) {
+            for (int j = ti == tj ? i + 1 : tj * HAUSDORFF_TILE; j < j1; j++) {
+                if (hausdorff_index_lower_bound(&index[i], &index[j]) > threshold) {
+                    p->pruned++;
+                    continue;
+                }
+                double d = hausdorff_index_distance(&index[i], &index[j], threshold);
+                if (d <= threshold) failed |= hausdorff_pairs_push(p, i, j, d) != 0;
+            }
+        }
+    }
+    // 合并：每个分块内已按 (i, j) 有序；同一行块按 i 逐行、再按 tj 依次取出该行的一段，得到全局顺序
+    long *cursor = (long *) calloc((size_t) (tiles > 0 ? tiles : 1), sizeof(long));
+    failed |= cursor == NULL;
+    for (int ti = 0; ti < tiles && !failed; ti++) {
+        for (int tj = ti; tj < tiles; tj++) {
+            cursor[tj] = 0;
+            out->pruned += local[(long) ti * tiles + tj].pruned;
+        }
+        int i1 = (ti + 1) * HAUSDORFF_TILE < count ? (ti + 1) * HAUSDORFF_TILE : count;
+        for (int i = ti * HAUSDORFF_TILE; i < i1 && !failed; i++) {
+            for (int tj = ti; tj < tiles && !failed; tj++) {
+                HausdorffPairs *p = &local[(long) ti * tiles + tj];
+                for (long *k = &cursor[tj]; *k < p->count && p->i[*k] == i && !failed; (*k)++) {
+                    failed |= hausdorff_pairs_push(out, i, p->j[*k], p->dist[*k]) != 0;
+                }
+            }
+        }
+    }
+    free(cursor);
+    for (long t = 0; t < total; t++) hausdorff_pairs_free(&local[t]);
+    free(local);
+    hausdorff_index_free_all(index, count);
+    return failed ? -1 : 0;
+}
+
+#endif // HAUSDORFF_MATRIX_H
@@ -1,6 +1,9 @@
 import random
 import numpy as np
 
+# 设置种子以确保生成的点集可复现
+random.seed(42)
+
 # 原始数据点集
 set1 = np.array([[0, 0], [1, 2], [3, 3], [4, 0]])
 set2 = np.array([[0, 0], [1, 1], [3, 2], [4, 0]])
@@ -0,0 +1,290 @@
+/**
+ * @Descripttion: 任意维点云：SoA 容器、按维数展开的距离核、分块包围盒索引与 Hausdorff 距离
+ * @filename: point_cloud.hpp
+ * @Author: 王春博
+ * @Date: 2026.10.19
+ * @Version: V1.0
+ *
+ * 模板参数 D 为编译期维数（2、3、4 等，维数循环完全展开）；D = CLOUD_DYNAMIC 时维数在构造时给出，用于高维特征向量。
+ * 索引：沿包围盒最长的坐标轴按中位数递归二分，每 CLOUD_BLOCK 个点一块，记录每块的包围盒；
+ * 块尾不足时用块内最后一点补齐，块内核总是定长循环，按维数在外、点在内的顺序累加，跨点向量化。
+ * 单向距离的剪枝沿用 hausdorff_matrix.h 平面索引的做法：抽样点先抬高最大值，整块不可能抬高最大值的块跳过，
+ * 离当前最小值更远的块跳过，最小值不超过已知最大值即早停；包围盒各面坐标差的最大值是 Hausdorff 距离的下界。
+ * 平面点集以 hausdorff_matrix.h 的 HausdorffIndex 为准（全对距离矩阵与基准测试都用它），这里不提供编译期二维的索引；
+ * CloudIndex 用于三维及以上和运行时维数，批量工具按统一格式读入的平面文件也走运行时维数。
+ */
+
+#ifndef POINT_CLOUD_HPP
+#define POINT_CLOUD_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <new>
+#include <numeric>
+#include <vector>
+
+#define CLOUD_DYNAMIC 0            // 运行时维数
+#define CLOUD_BLOCK 16             // 索引中每块的点数
+#define CLOUD_STRIDE 16            // 单向距离先处理的抽样点步长
+#define CLOUD_PARALLEL_BLOCKS 256  // 点集块数不少于此数时单向距离并行
+
+template <int D>
+class PointCloud {
+    static_assert(D >= 0, "维数不能为负");
+
+public:
+    explicit PointCloud(int dim = D) : dim_(D > 0 ? D : dim), axis_(D > 0 ? D : dim) {}
+
+    int dim() const {
+        if constexpr (D > 0) return D;
+        return dim_;
+    }
+    int size() const { return count_; }
+    const double *axis(int d) const { return axis_[d].data(); }
+    double at(int i, int d) const { return axis_[d][i]; }
+
+    void reserve(int n) {
+        for (auto &a : axis_) a.reserve(n);
+    }
+    // 追加一点，p 为 dim() 个坐标
+    void push(const double *p) {
+        for (int d = 0; d < dim(); d++) axis_[d].push_back(p[d]);
+        count_++;
+    }
+    void clear() {
+        for (auto &a : axis_) a.clear();
+        count_ = 0;
+    }
+
+private:
+    int dim_;
+    int count_ = 0;
+    std::vector<std::vector<double>> axis_;  // axis_[d][i] 为第 i 点的第 d 个坐标
+};
+
+template <int D>
+class CloudIndex {
+    static_assert(D != 2, "平面点集请用 hausdorff_matrix.h 的 HausdorffIndex");
+
+public:
+    // 建立索引，成功返回 0，内存不足返回 -1
+    int build(const PointCloud<D> &c) {
+        dim_ = c.dim();
+        count_ = c.size();
+        blocks_ = (count_ + CLOUD_BLOCK - 1) / CLOUD_BLOCK;
+        padded_ = blocks_ * CLOUD_BLOCK;
+        int dim = this->dim();
+        try {
+            std::vector<int> order(count_);
+            std::iota(order.begin(), order.end(), 0);
+            split(c, order.data(), count_);
+            coord_.assign((size_t) dim * padded_, 0.0);
+            box_.assign((size_t) 2 * dim * blocks_, 0.0);
+            lo_.assign(dim, INFINITY);
+            hi_.assign(dim, -INFINITY);
+            for (int d = 0; d < dim; d++) {
+                double *x = &coord_[(size_t) d * padded_];
+                for (int i = 0; i < padded_; i++) x[i] = c.at(order[i < count_ ? i : count_ - 1], d);
+            }
+        } catch (const std::bad_alloc &) {
+            count_ = blocks_ = padded_ = 0;
+            return -1;
+        }
+        for (int k = 0; k < blocks_; k++) {
+            double *blo = &box_[(size_t) 2 * k * dim], *bhi = blo + dim;
+            for (int d = 0; d < dim; d++) {
+                const double *x = axis(d) + k * CLOUD_BLOCK;
+                double mn = INFINITY, mx = -INFINITY;
+                for (int j = 0; j < CLOUD_BLOCK; j++) {
+                    mn = x[j] < mn ? x[j] : mn;
+                    mx = x[j] > mx ? x[j] : mx;
+                }
+                blo[d] = mn;
+                bhi[d] = mx;
+                lo_[d] = mn < lo_[d] ? mn : lo_[d];
+                hi_[d] = mx > hi_[d] ? mx : hi_[d];
+            }
+        }
+        return 0;
+    }
+
+    int dim() const {
+        if constexpr (D > 0) return D;
+        return dim_;
+    }
+    int size() const { return count_; }
+    int blocks() const { return blocks_; }
+    // 第 d 个坐标轴（重排并补齐后），长度为 blocks() * CLOUD_BLOCK
+    const double *axis(int d) const { return coord_.data() + (size_t) d * padded_; }
+    const double *box_lo(int k) const { return box_.data() + (size_t) 2 * k * dim(); }
+    const double *box_hi(int k) const { return box_lo(k) + dim(); }
+    const double *lo() const { return lo_.data(); }
+    const double *hi() const { return hi_.data(); }
+
+    // 块 k 中离 q 最近点的平方距离
+    double block_min_sq(int k, const double *q) const {
+        double acc[CLOUD_BLOCK] = {};
+        size_t base = (size_t) k * CLOUD_BLOCK;
+        for (int d = 0; d < dim(); d++) {
+            const double *x = coord_.data() + (size_t) d * padded_ + base;
+            double qd = q[d];
+            #pragma omp simd
+            for (int j = 0; j < CLOUD_BLOCK; j++) {
+                double t = x[j] - qd;
+                acc[j] += t * t;
+            }
+        }
+        double m = acc[0];
+        #pragma omp simd reduction(min:m)
+        for (int j = 1; j < CLOUD_BLOCK; j++) m = acc[j] < m ? acc[j] : m;
+        return m;
+    }
+
+    // q 到块 k 包围盒的平方距离
+    double box_dist_sq(int k, const double *q) const {
+        const double *blo = box_lo(k), *bhi = box_hi(k);
+        double s = 0.0;
+        for (int d = 0; d < dim(); d++) {
+            double t = q[d] < blo[d] ? blo[d] - q[d] : (q[d] > bhi[d] ? q[d] - bhi[d] : 0.0);
+            s += t * t;
+        }
+        return s;
+    }
+
+    // q 到块 k 包围盒最远角的平方距离
+    double box_far_sq(int k, const double *q) const {
+        const double *blo = box_lo(k), *bhi = box_hi(k);
+        double s = 0.0;
+        for (int d = 0; d < dim(); d++) {
+            double a = q[d] - blo[d], b = bhi[d] - q[d];
+            double t = a > b ? a : b;
+            s += t * t;
+        }
+        return s;
+    }
+
+    // q 到本点集的最近平方距离，不超过 stop_sq 即可提前返回；*hint 为上一次的最近块，先扫它得到较小的初值
+    double point_sq(const double *q, double stop_sq, int *hint) const {
+        double cmin = block_min_sq(*hint, q);
+        for (int k = 0; k < blocks_ && cmin > stop_sq; k++) {
+            if (k == *hint || box_dist_sq(k, q) >= cmin) continue;
+            double m = block_min_sq(k, q);
+            if (m < cmin) {
+                cmin = m;
+                *hint = k;
+            }
+        }
+        return cmin;
+    }
+
+private:
+    // 沿最长轴按中位数二分 idx[0 .. n)，分界点取 CLOUD_BLOCK 的整数倍，使每块的点在空间上聚集
+    void split(const PointCloud<D> &c, int *idx, int n) {
+        if (n <= CLOUD_BLOCK) return;
+        int axis = 0;
+        double widest = -1.0;
+        for (int d = 0; d < c.dim(); d++) {
+            const double *x = c.axis(d);
+            double mn = INFINITY, mx = -INFINITY;
+            for (int i = 0; i < n; i++) {
+                mn = x[idx[i]] < mn ? x[idx[i]] : mn;
+                mx = x[idx[i]] > mx ? x[idx[i]] : mx;
+            }
+            if (mx - mn > widest) {
+                widest = mx - mn;
+                axis = d;
+            }
+        }
+        int mid = (n / 2 + CLOUD_BLOCK - 1) / CLOUD_BLOCK * CLOUD_BLOCK;
+        const double *x = c.axis(axis);
+        std::nth_element(idx, idx + mid, idx + n, [x](int p, int q) { return x[p] < x[q]; });
+        split(c, idx, mid);
+        split(c, idx + mid, n - mid);
+    }
+
+    int dim_ = D;
+    int count_ = 0;
+    int blocks_ = 0;
+    int padded_ = 0;
+    std::vector<double> coord_;  // coord_[d * padded_ + i]
+    std::vector<double> box_;    // 块 k：box_[2k * dim ..] 为各维最小值，其后 dim 个为最大值
+    std::vector<double> lo_, hi_;
+};
+
+// 包围盒给出的 Hausdorff 距离下界
+template <int D>
+inline double cloud_lower_bound(const CloudIndex<D> &a, const CloudIndex<D> &b) {
+    double s = 0.0;
+    for (int d = 0; d < a.dim(); d++) {
+        double t = std::fabs(a.lo()[d] - b.lo()[d]), u = std::fabs(a.hi()[d] - b.hi()[d]);
+        t = u > t ? u : t;
+        s = t > s ? t : s;
+    }
+    return s;
+}
+
+// max(lower_sq, a 到 b 单向距离的平方)；超过 limit_sq 后尽快返回（此时返回值只保证大于 limit_sq）。
+// a 的块数不少于 CLOUD_PARALLEL_BLOCKS 时逐块部分由各线程分担，每个线程用自己的最大值早停
+template <int D>
+inline double cloud_directed_sq(const CloudIndex<D> &a, const CloudIndex<D> &b, double lower_sq, double limit_sq) {
+    if (b.size() == 0) return a.size() > 0 ? INFINITY : lower_sq;
+    const int dim = a.dim();
+    double cmax = lower_sq;
+    int hint = 0;
+    // 先按步长 CLOUD_STRIDE 抽样，cmax 很快接近最终值
+    std::vector<double> q(dim);
+    for (int i = 0; i < a.size(); i += CLOUD_STRIDE) {
+        for (int d = 0; d < dim; d++) q[d] = a.axis(d)[i];
+        double cmin = b.point_sq(q.data(), cmax, &hint);
+        if (cmin > cmax) {
+            cmax = cmin;
+            if (cmax > limit_sq) return cmax;
+        }
+    }
+    // 再逐块处理其余点：b 中某点到 a 块包围盒最远角的距离不超过 cmax 时，块内的点都不可能抬高 cmax，整块跳过
+    const double start = cmax;
+    #pragma omp parallel if (a.blocks() >= CLOUD_PARALLEL_BLOCKS)
+    {
+        double local = start;
+        int h = hint;
+        std::vector<double> p(dim), r(dim);
+        #pragma omp for schedule(dynamic, 4) nowait
+        for (int ka = 0; ka < a.blocks(); ka++) {
+            if (local > limit_sq) continue;
+            for (int d = 0; d < dim; d++) r[d] = b.axis(d)[h * CLOUD_BLOCK];
+            if (a.box_far_sq(ka, r.data()) <= local) continue;
+            int lo = ka * CLOUD_BLOCK, hi = std::min(lo + CLOUD_BLOCK, a.size());
+            for (int i = lo; i < hi && local <= limit_sq; i++) {
+                if (i % CLOUD_STRIDE == 0) continue;
+                for (int d = 0; d < dim; d++) p[d] = a.axis(d)[i];
+                double cmin = b.point_sq(p.data(), local, &h);
+                local = cmin > local ? cmin : local;
+            }
+        }
+        #pragma omp critical
+        cmax = local > cmax ? local : cmax;
+    }
+    return cmax;
+}
+
+// 两个索引之间的 Hausdorff 距离；大于 limit 时返回值只保证大于 limit（limit 取 INFINITY 为精确值）。维数不同返回 NAN
+template <int D>
+inline double cloud_hausdorff(const CloudIndex<D> &a, const CloudIndex<D> &b, double limit = INFINITY) {
+    if (a.dim() != b.dim()) return NAN;
+    double lb = cloud_lower_bound(a, b);
+    if (lb > limit) return lb;
+    double limit_sq = limit * limit;
+    double ab = cloud_directed_sq(a, b, lb * lb, limit_sq);
+    if (ab > limit_sq) return std::sqrt(ab);
+    return std::sqrt(cloud_directed_sq(b, a, ab, limit_sq));
+}
+
+// 直接由点云计算：两边各建一次索引。维数不同或内存不足返回 NAN
+template <int D>
+inline double cloud_hausdorff(const PointCloud<D> &a, const PointCloud<D> &b) {
+    CloudIndex<D> ia, ib;
+    if (a.dim() != b.dim() || ia.build(a) != 0 || ib.build(b) != 0) return NAN;
+    return cloud_hausdorff(ia, ib);
+}
+
+#endif // POINT_CLOUD_HPP
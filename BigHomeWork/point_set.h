@@ -0,0 +1,84 @@
+/**
+ * @Descripttion: 平面点集容器（SoA 存放），曲线离散化与 Hausdorff 距离计算共用
+ * @filename: point_set.h
+ * @Author: 王春博
+ * @Date: 2026.10.19
+ * @Version: V1.0
+ *
+ * x、y 分别连续存放，距离计算的内层循环可直接向量化；容量按倍增扩张，离散化时逐点追加无需拷贝。
+ * 读入函数支持两种数据格式：in.txt 的“点数 + 坐标”分组格式，random_set 的逐行坐标格式。
+ */
+
+#ifndef POINT_SET_H
+#define POINT_SET_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+typedef struct {
+    int count;
+    int capacity;
+    double *x;
+    double *y;
+} PointSet;
+
+static inline void point_set_init(PointSet *s) {
+    s->count = 0;
+    s->capacity = 0;
+    s->x = NULL;
+    s->y = NULL;
+}
+
+static inline void point_set_free(PointSet *s) {
+    free(s->x);
+    free(s->y);
+    point_set_init(s);
+}
+
+// 保证容量不小于 capacity，成功返回 0
+static inline int point_set_reserve(PointSet *s, int capacity) {
+    if (capacity <= s->capacity) return 0;
+    double *x = (double *) realloc(s->x, (size_t) capacity * sizeof(double));
+    if (x == NULL) return -1;
+    s->x = x;
+    double *y = (double *) realloc(s->y, (size_t) capacity * sizeof(double));
+    if (y == NULL) return -1;
+    s->y = y;
+    s->capacity = capacity;
+    return 0;
+}
+
+static inline int point_set_push(PointSet *s, double x, double y) {
+    if (s->count == s->capacity && point_set_reserve(s, s->capacity > 0 ? 2 * s->capacity : 64) != 0) return -1;
+    s->x[s->count] = x;
+    s->y[s->count] = y;
+    s->count++;
+    return 0;
+}
+
+static inline void point_set_clear(PointSet *s) {
+    s->count = 0;
+}
+
+// 读入一组“点数 n，随后 n 行 x y”的数据（in.txt 格式），追加到 s；成功返回 0，格式错误或内存不足返回 -1
+static inline int point_set_read_counted(FILE *file, PointSet *s) {
+    int n;
+    if (fscanf(file, "%d", &n) != 1 || n < 0) return -1;
+    if (point_set_reserve(s, s->count + n) != 0) return -1;
+    for (int i = 0; i < n; i++) {
+        if (fscanf(file, "%lf %lf", &s->x[s->count], &s->y[s->count]) != 2) return -1;
+        s->count++;
+    }
+    return 0;
+}
+
+// 读入文件剩余的全部“x y”坐标（random_set 格式），追加到 s；成功返回 0，内存不足返回 -1
+static inline int point_set_read_all(FILE *file, PointSet *s) {
+    double x, y;
+    while (fscanf(file, "%lf %lf", &x, &y) == 2) {
+        if (point_set_push(s, x, y) != 0) return -1;
+    }
+    return 0;
+}
+
+#endif // POINT_SET_H
@@ -0,0 +1,226 @@
+/**
+ * @Descripttion: 折线/贝塞尔曲线之间的精确 Hausdorff 距离：线段包围盒层次（BVH）最近距离查询 + 沿线段的分支定界
+ * @filename: segment_hausdorff.h
+ * @Author: 王春博
+ * @Date: 2026.10.19
+ * @Version: V1.0
+ *
+ * 单向距离 h(A, B) = sup_{p in A} d(p, B)，p 取遍折线 A 上的所有点而不只是顶点。
+ * d(., B) 是 1-Lipschitz 函数，在 A 的一段 [p, q] 上的最大值不超过 (d(p) + d(q) + |pq|) / 2，
+ * 上界不超过当前已知下界 + eps 的区间直接舍弃，否则对分；每次 d(p, B) 由 BVH 查询，剪掉远处的包围盒。
+ * 折线顶点按顺序相连，相邻线段在空间上也相邻，BVH 直接按下标二分建树，O(n) 建成。
+ */
+
+#ifndef SEGMENT_HAUSDORFF_H
+#define SEGMENT_HAUSDORFF_H
+
+#include <stdlib.h>
+#include <math.h>
+#include "point_set.h"
+#include "bezier.h"
+
+#define SEG_BVH_LEAF 4        // 叶结点的线段数
+#define SEG_BVH_STACK 64      // 查询栈深度（按下标二分建树，深度约 log2(n / SEG_BVH_LEAF)）
+#define SEG_HAUSDORFF_STACK 64 // 分支定界的区间栈深度
+
+// 结点 k 的子结点为 2k+1、2k+2，覆盖线段 [lo[k], hi[k])
+typedef struct {
+    const PointSet *line;
+    int nodes;
+    int *lo, *hi;
+    double *min_x, *min_y, *max_x, *max_y;
+} SegmentBvh;
+
+static inline void seg_bvh_free(SegmentBvh *t) {
+    free(t->lo);
+    free(t->hi);
+    free(t->min_x);
+    free(t->min_y);
+    free(t->max_x);
+    free(t->max_y);
+    t->lo = t->hi = NULL;
+    t->min_x = t->min_y = t->max_x = t->max_y = NULL;
+}
+
+// 自底向上计算包围盒
+static inline void seg_bvh_fit(SegmentBvh *t, int k) {
+    const double *x = t->line->x, *y = t->line->y;
+    if (t->hi[k] - t->lo[k] <= SEG_BVH_LEAF || 2 * k + 2 >= t->nodes) {
+        double x0 = INFINITY, y0 = INFINITY, x1 = -INFINITY, y1 = -INFINITY;
+        for (int i = t->lo[k]; i <= t->hi[k]; i++) {  // 线段 i 的端点为顶点 i、i+1
+            x0 = x[i] < x0 ? x[i] : x0;
+            y0 = y[i] < y0 ? y[i] : y0;
+            x1 = x[i] > x1 ? x[i] : x1;
+            y1 = y[i] > y1 ? y[i] : y1;
+        }
+        t->min_x[k] = x0;
+        t->min_y[k] = y0;
+        t->max_x[k] = x1;
+        t->max_y[k] = y1;
+        return;
+    }
+    int l = 2 * k + 1, r = 2 * k + 2;
+    seg_bvh_fit(t, l);
+    seg_bvh_fit(t, r);
+    t->min_x[k] = fmin(t->min_x[l], t->min_x[r]);
+    t->min_y[k] = fmin(t->min_y[l], t->min_y[r]);
+    t->max_x[k] = fmax(t->max_x[l], t->max_x[r]);
+    t->max_y[k] = fmax(t->max_y[l], t->max_y[r]);
+}
+
+// 为至少两个顶点的折线建树，成功返回 0
+static inline int seg_bvh_build(SegmentBvh *t, const PointSet *line) {
+    int segments = line->count - 1;
+    t->line = line;
+    int leaves = 1;
+    while (leaves * SEG_BVH_LEAF < segments) leaves *= 2;
+    t->nodes = 2 * leaves - 1;
+    size_t bytes = (size_t) t->nodes * sizeof(double);
+    t->lo = (int *) calloc((size_t) t->nodes, sizeof(int));
+    t->hi = (int *) calloc((size_t) t->nodes, sizeof(int));
+    t->min_x = (double *) malloc(bytes);
+    t->min_y = (double *) malloc(bytes);
+    t->max_x = (double *) malloc(bytes);
+    t->max_y = (double *) malloc(bytes);
+    if (segments < 1 || t->lo == NULL || t->hi == NULL || t->min_x == NULL || t->min_y == NULL ||
+        t->max_x == NULL || t->max_y == NULL) {
+        seg_bvh_free(t);
+        return -1;
+    }
+    // 按下标对分；空结点 hi = lo = 0 且不会被访问
+    t->lo[0] = 0;
+    t->hi[0] = segments;
+    for (int k = 0; 2 * k + 2 < t->nodes; k++) {
+        int lo = t->lo[k], hi = t->hi[k];
+        if (hi - lo <= SEG_BVH_LEAF) continue;
+        int mid = lo + (hi - lo) / 2;
+        t->lo[2 * k + 1] = lo;
+        t->hi[2 * k + 1] = mid;
+        t->lo[2 * k + 2] = mid;
+        t->hi[2 * k + 2] = hi;
+    }
+    seg_bvh_fit(t, 0);
+    return 0;
+}
+
+static inline double seg_box_dist_sq(const SegmentBvh *t, int k, double px, double py) {
+    double dx = px < t->min_x[k] ? t->min_x[k] - px : (px > t->max_x[k] ? px - t->max_x[k] : 0.0);
+    double dy = py < t->min_y[k] ? t->min_y[k] - py : (py > t->max_y[k] ? py - t->max_y[k] : 0.0);
+    return dx * dx + dy * dy;
+}
+
+// 点到折线的最小平方距离；best 为已知上界（如相邻查询点的结果加步长），可加速剪枝
+static inline double seg_bvh_dist_sq(const SegmentBvh *t, double px, double py, double best) {
+    const double *x = t->line->x, *y = t->line->y;
+    int stack[SEG_BVH_STACK], top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        int k = stack[--top];
+        if (seg_box_dist_sq(t, k, px, py) >= best) continue;
+        int l = 2 * k + 1, r = 2 * k + 2;
+        if (t->hi[k] - t->lo[k] <= SEG_BVH_LEAF || r >= t->nodes) {
+            for (int i = t->lo[k]; i < t->hi[k]; i++) {
+                double d = bezier_segment_dist_sq(px, py, x[i], y[i], x[i + 1], y[i + 1]);
+                best = d < best ? d : best;
+            }
+            continue;
+        }
+        // 先访问近的子结点
+        double dl = seg_box_dist_sq(t, l, px, py), dr = seg_box_dist_sq(t, r, px, py);
+        if (dl < dr) {
+            stack[top++] = r;
+            stack[top++] = l;
+        } else {
+            stack[top++] = l;
+            stack[top++] = r;
+        }
+    }
+    return best;
+}
+
+// 折线 a 到折线 b 的精确单向 Hausdorff 距离（绝对误差不超过 eps），内存不足返回 -1
+static inline double segment_hausdorff_directed(const PointSet *a, const SegmentBvh *tb, double eps) {
+    int n = a->count;
+    double *dist = (double *) malloc((size_t) (n > 0 ? n : 1) * sizeof(double));
+    if (dist == NULL) return -1.0;
+    double lower = 0.0;
+    // 先求所有顶点的距离，最大者为初始下界
+    #pragma omp parallel for schedule(dynamic, 64) reduction(max:lower)
+    for (int i = 0; i < n; i++) {
+        dist[i] = sqrt(seg_bvh_dist_sq(tb, a->x[i], a->y[i], INFINITY));
+        lower = dist[i] > lower ? dist[i] : lower;
+    }
+    // 各线段内部分支定界：区间 [s0, s1] 两端的距离为 f0、f1；各线程的下界都是最终结果的下界
+    double vertex_lower = lower;
+    #pragma omp parallel for schedule(dynamic, 16) reduction(max:lower)
+    for (int i = 0; i < n - 1; i++) {
+        double ax = a->x[i], ay = a->y[i];
+        double ux = a->x[i + 1] - ax, uy = a->y[i + 1] - ay;
+        double len = sqrt(ux * ux + uy * uy);
+        double s0[SEG_HAUSDORFF_STACK], s1[SEG_HAUSDORFF_STACK], f0[SEG_HAUSDORFF_STACK], f1[SEG_HAUSDORFF_STACK];
+        double best = lower > vertex_lower ? lower : vertex_lower;
+        s0[0] = 0.0;
+        s1[0] = 1.0;
+        f0[0] = dist[i];
+        f1[0] = dist[i + 1];
+        int top = 1;
+        while (top > 0) {
+            top--;
+            double a0 = s0[top], a1 = s1[top], g0 = f0[top], g1 = f1[top];
+            double half = 0.5 * (a1 - a0) * len;
+            if (0.5 * (g0 + g1) + half <= best + eps) continue;
+            // 中点距离不超过较近一端的距离 + 半区间长，作为查询的初始上界
+            double m = 0.5 * (a0 + a1);
+            double bound = (g0 < g1 ? g0 : g1) + half;
+            double gm = sqrt(seg_bvh_dist_sq(tb, ax + m * ux, ay + m * uy, bound * bound * (1.0 + 1e-12)));
+            best = gm > best ? gm : best;
+            if (top + 2 > SEG_HAUSDORFF_STACK) continue;  // 区间已小到浮点分辨率
+            s0[top] = m;
+            s1[top] = a1;
+            f0[top] = gm;
+            f1[top] = g1;
+            top++;
+            s0[top] = a0;
+            s1[top] = m;
+            f0[top] = g0;
+            f1[top] = gm;
+            top++;
+        }
+        lower = best > lower ? best : lower;
+    }
+    free(dist);
+    return lower;
+}
+
+// 两条折线之间的精确 Hausdorff 距离（绝对误差不超过 eps）；任一折线少于两个顶点或内存不足时返回 -1
+static inline double segment_hausdorff(const PointSet *a, const PointSet *b, double eps) {
+    SegmentBvh ta, tb;
+    if (seg_bvh_build(&ta, a) != 0) return -1.0;
+    if (seg_bvh_build(&tb, b) != 0) {
+        seg_bvh_free(&ta);
+        return -1.0;
+    }
+    double ab = segment_hausdorff_directed(a, &tb, eps);
+    double ba = segment_hausdorff_directed(b, &ta, eps);
+    seg_bvh_free(&ta);
+    seg_bvh_free(&tb);
+    if (ab < 0.0 || ba < 0.0) return -1.0;
+    return ab > ba ? ab : ba;
+}
+
+// 平面贝塞尔曲线之间的 Hausdorff 距离：两条曲线各自自适应离散化到 tol / 2（曲线与折线的 Hausdorff 距离不超过 tol / 2），
+// 由三角不等式，折线间的精确距离与曲线间的真实距离相差约不超过 tol（细分深度达到上限的段除外）
+static inline double bezier_hausdorff(const double *ctrl_a, int degree_a, const double *ctrl_b, int degree_b, double tol) {
+    PointSet a, b;
+    point_set_init(&a);
+    point_set_init(&b);
+    double result = -1.0;
+    if (bezier_flatten(ctrl_a, degree_a, 0.5 * tol, &a) == 0 && bezier_flatten(ctrl_b, degree_b, 0.5 * tol, &b) == 0) {
+        result = segment_hausdorff(&a, &b, 1e-3 * tol);
+    }
+    point_set_free(&a);
+    point_set_free(&b);
+    return result;
+}
+
+#endif // SEGMENT_HAUSDORFF_H
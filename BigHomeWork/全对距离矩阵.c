@@ -0,0 +1,111 @@
+/**
+ * @Descripttion: 曲线库全对 Hausdorff 距离：逐对调用与批量索引（稠密矩阵 / 阈值稀疏矩阵）的耗时与结果比较
+ * @filename: 全对距离矩阵.c
+ * @Author: 王春博
+ * @Date: 2026.10.19
+ * @Version: V1.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "../common/bench.h"
+#include "../common/rng.h"
+#include "bezier.h"
+#include "hausdorff.h"
+#include "hausdorff_matrix.h"
+
+#define CURVES 1000        // 曲线库中的曲线条数
+#define SAMPLES 256        // 每条曲线的采样点数
+#define CHECK_PAIRS 20000  // 逐对计算的抽样对数
+#define THRESHOLD 3.0      // 稀疏矩阵的距离阈值
+
+// 随机三次贝塞尔曲线库：起点散布在 100 x 100 的区域内，曲线尺度约为 10。sets 须已初始化；成功返回 0，内存不足返回 -1
+int build_library(Rng *rng, PointSet *sets, int count) {
+    double ctrl[8], soa[2 * SAMPLES];
+    int offset[2] = {0, 4};
+    BezierSet set = {1, 2, offset, ctrl};
+    for (int c = 0; c < count; c++) {
+        double x0 = rng_uniform_range(rng, 0, 100), y0 = rng_uniform_range(rng, 0, 100);
+        for (int i = 0; i < 4; i++) {
+            ctrl[2 * i] = x0 + 3 * i + rng_uniform_range(rng, -2, 2);
+            ctrl[2 * i + 1] = y0 + rng_uniform_range(rng, -4, 4);
+        }
+        if (bezier_sample_uniform(&set, SAMPLES, soa) != 0 || point_set_reserve(&sets[c], SAMPLES) != 0) return -1;
+        for (int k = 0; k < SAMPLES; k++) point_set_push(&sets[c], soa[k], soa[SAMPLES + k]);
+    }
+    return 0;
+}
+
+// 逐对抽样、稠密矩阵与阈值稀疏矩阵三种算法的比较；成功返回 0，内存不足返回 -1
+int run(Rng *rng, const PointSet *sets, double *matrix, int *pi, int *pj, double *pd) {
+    long pairs = (long)CURVES * (CURVES - 1) / 2;
+    printf("曲线库: %d 条曲线，每条 %d 点，共 %ld 对\n", CURVES, SAMPLES, pairs);
+
+    // 逐对调用：抽样计时后折算到全部对
+    for (int k = 0; k < CHECK_PAIRS; k++) {
+        pi[k] = (int)rng_below(rng, CURVES);
+        pj[k] = (pi[k] + 1 + (int)rng_below(rng, CURVES - 1)) % CURVES;
+    }
+    double t0 = bench_now();
+    for (int k = 0; k < CHECK_PAIRS; k++) pd[k] = hausdorff_distance_sets(&sets[pi[k]], &sets[pj[k]]);
+    double t1 = bench_now();
+    printf("逐对调用: 抽样 %d 对 %.1f ms，折算全部约 %.1f s\n", CHECK_PAIRS, (t1 - t0) * 1e3,
+           (t1 - t0) * pairs / CHECK_PAIRS);
+
+    // 稠密矩阵
+    t0 = bench_now();
+    if (hausdorff_matrix_dense(sets, CURVES, matrix) != 0) return -1;
+    t1 = bench_now();
+    double err = 0.0;
+    for (int k = 0; k < CHECK_PAIRS; k++) err = fmax(err, fabs(matrix[(long)pi[k] * CURVES + pj[k]] - pd[k]));
+    printf("稠密矩阵: %.1f s，与逐对结果最大差 %.2e\n", t1 - t0, err);
+
+    // 阈值稀疏矩阵
+    HausdorffPairs result;
+    hausdorff_pairs_init(&result);
+    t0 = bench_now();
+    if (hausdorff_matrix_sparse(sets, CURVES, THRESHOLD, &result) != 0) {
+        hausdorff_pairs_free(&result);
+        return -1;
+    }
+    t1 = bench_now();
+    long expected = 0, mismatch = 0;
+    for (int i = 0; i < CURVES; i++) {
+        for (int j = i + 1; j < CURVES; j++) expected += matrix[(long)i * CURVES + j] <= THRESHOLD;
+    }
+    for (long k = 0; k < result.count; k++) {
+        mismatch += result.dist[k] != matrix[(long)result.i[k] * CURVES + result.j[k]];
+    }
+    printf("阈值 %.1f 稀疏矩阵: %.3f s，%ld 对（稠密矩阵中 %ld 对，距离不一致 %ld 对），包围盒剪掉 %ld 对\n", THRESHOLD,
+           t1 - t0, result.count, expected, mismatch, result.pruned);
+    hausdorff_pairs_free(&result);
+    return 0;
+}
+
+int main() {
+    PointSet *sets = (PointSet *)malloc(CURVES * sizeof(PointSet));
+    double *matrix = (double *)malloc((size_t)CURVES * CURVES * sizeof(double));
+    int *pi = (int *)malloc(CHECK_PAIRS * sizeof(int)), *pj = (int *)malloc(CHECK_PAIRS * sizeof(int));
+    double *pd = (double *)malloc(CHECK_PAIRS * sizeof(double));
+    int status = -1;
+    if (sets != NULL) {
+        for (int c = 0; c < CURVES; c++) point_set_init(&sets[c]);
+    }
+    Rng rng;
+    rng_init(&rng, 2026);
+    if (sets != NULL && matrix != NULL && pi != NULL && pj != NULL && pd != NULL && build_library(&rng, sets, CURVES) == 0) {
+        status = run(&rng, sets, matrix, pi, pj, pd);
+    }
+    if (status != 0) printf("内存不足\n");
+
+    if (sets != NULL) {
+        for (int c = 0; c < CURVES; c++) point_set_free(&sets[c]);
+    }
+    free(sets);
+    free(matrix);
+    free(pi);
+    free(pj);
+    free(pd);
+    return status == 0 ? 0 : 1;
+}
@@ -0,0 +1,174 @@
+/**
+ * @Descripttion: 任意维 Hausdorff 距离：平面数据上原实现与平面索引对照，三维激光扫描点云与高维特征向量上索引与暴力计算的结果与耗时比较
+ * @filename: 多维Hausdorff.cpp
+ * @Author: 王春博
+ * @Date: 2026.10.19
+ * @Version: V1.0
+ */
+
+#include <cstdio>
+#include <cmath>
+#include "../common/bench.h"
+#include "../common/rng.h"
+#include "hausdorff.h"
+#include "hausdorff_matrix.h"
+#include "point_cloud.hpp"
+
+#define SCAN_POINTS 200000   // 每次扫描的点数
+#define CHECK_POINTS 20000   // 与暴力计算对照的规模
+#define FEATURE_DIM 32       // 特征向量维数
+#define FEATURE_POINTS 20000
+#define FEATURE_CLUSTERS 64
+
+// 暴力单向距离平方，按点早停，作为对照
+template <int D>
+double brute_directed_sq(const PointCloud<D> &a, const PointCloud<D> &b) {
+    int dim = a.dim();
+    double cmax = 0.0;
+    #pragma omp parallel for schedule(dynamic, 64) reduction(max:cmax)
+    for (int i = 0; i < a.size(); i++) {
+        double cmin = INFINITY;
+        for (int j = 0; j < b.size() && cmin > cmax; j++) {
+            double s = 0.0;
+            for (int d = 0; d < dim; d++) {
+                double t = a.at(i, d) - b.at(j, d);
+                s += t * t;
+            }
+            cmin = s < cmin ? s : cmin;
+        }
+        cmax = cmin > cmax ? cmin : cmax;
+    }
+    return cmax;
+}
+
+template <int D>
+double brute_hausdorff(const PointCloud<D> &a, const PointCloud<D> &b) {
+    return sqrt(fmax(brute_directed_sq(a, b), brute_directed_sq(b, a)));
+}
+
+// 模拟激光扫描：起伏地面上的随机采样加测距噪声；moved 为真时地面整体平移并多出一个立方体障碍物
+template <int D>
+void lidar_scan(PointCloud<D> *c, int n, bool moved, uint64_t seed) {
+    Rng rng;
+    rng_init(&rng, seed);
+    c->clear();
+    c->reserve(n);
+    for (int i = 0; i < n; i++) {
+        double p[3];
+        if (moved && i % 50 == 0) {
+            p[0] = rng_uniform_range(&rng, 40, 42);
+            p[1] = rng_uniform_range(&rng, 60, 62);
+            p[2] = rng_uniform_range(&rng, 3, 5);
+        } else {
+            p[0] = rng_uniform_range(&rng, 0, 100);
+            p[1] = rng_uniform_range(&rng, 0, 100);
+            p[2] = 2 * sin(0.1 * p[0]) * cos(0.07 * p[1]) + 0.02 * rng_normal(&rng) + (moved ? 0.05 : 0.0);
+        }
+        c->push(p);
+    }
+}
+
+// 高维特征：FEATURE_CLUSTERS 个簇心附近的正态分布
+void feature_set(PointCloud<CLOUD_DYNAMIC> *c, int n, uint64_t seed) {
+    Rng rng;
+    rng_init(&rng, 20261019);  // 两组特征共用簇心
+    std::vector<double> center((size_t) FEATURE_CLUSTERS * FEATURE_DIM), p(FEATURE_DIM);
+    rng_fill_uniform(&rng, center.data(), center.size(), -10, 10);
+    rng_init(&rng, seed);
+    c->clear();
+    c->reserve(n);
+    for (int i = 0; i < n; i++) {
+        const double *m = &center[(size_t) rng_below(&rng, FEATURE_CLUSTERS) * FEATURE_DIM];
+        for (int d = 0; d < FEATURE_DIM; d++) p[d] = m[d] + rng_normal(&rng);
+        c->push(p.data());
+    }
+}
+
+// 同一批三维点复制成运行时维数的点云
+PointCloud<CLOUD_DYNAMIC> to_dynamic(const PointCloud<3> &c) {
+    PointCloud<CLOUD_DYNAMIC> r(3);
+    r.reserve(c.size());
+    for (int i = 0; i < c.size(); i++) {
+        double p[3] = {c.at(i, 0), c.at(i, 1), c.at(i, 2)};
+        r.push(p);
+    }
+    return r;
+}
+
+int main() {
+    // 平面数据：hausdorff.h 与 hausdorff_matrix.h 平面索引的结果对照
+    FILE *f1 = fopen("BigHomeWork/random_set1.txt", "r"), *f2 = fopen("BigHomeWork/random_set2.txt", "r");
+    if (f1 == NULL || f2 == NULL) {
+        perror("无法打开 random_set 数据（需在仓库根目录运行）");
+        return -1;
+    }
+    PointSet s1, s2;
+    point_set_init(&s1);
+    point_set_init(&s2);
+    point_set_read_all(f1, &s1);
+    point_set_read_all(f2, &s2);
+    fclose(f1);
+    fclose(f2);
+    HausdorffIndex h1, h2;
+    int ok = hausdorff_index_build(&h1, &s1) == 0;
+    ok = hausdorff_index_build(&h2, &s2) == 0 && ok;
+    if (ok) {
+        printf("平面 random_set（%d / %d 点）：原实现 %.6f，平面索引 %.6f\n", s1.count, s2.count,
+               hausdorff_distance_sets(&s1, &s2), hausdorff_index_distance(&h1, &h2, INFINITY));
+    } else {
+        printf("平面索引内存不足\n");
+    }
+    hausdorff_index_free(&h1);
+    hausdorff_index_free(&h2);
+    point_set_free(&s1);
+    point_set_free(&s2);
+
+    // 三维扫描：小规模与暴力对照
+    PointCloud<3> a, b;
+    lidar_scan(&a, CHECK_POINTS, false, 1);
+    lidar_scan(&b, CHECK_POINTS, true, 2);
+    double t0 = bench_now();
+    double ref = brute_hausdorff(a, b);
+    double t1 = bench_now();
+    double h3 = cloud_hausdorff(a, b);
+    double t2 = bench_now();
+    printf("三维扫描 %d 点：暴力 %.6f（%.1f ms），索引 %.6f（%.1f ms）\n", CHECK_POINTS, ref, (t1 - t0) * 1e3, h3,
+           (t2 - t1) * 1e3);
+
+    // 三维扫描：全规模，编译期维数与运行时维数
+    lidar_scan(&a, SCAN_POINTS, false, 1);
+    lidar_scan(&b, SCAN_POINTS, true, 2);
+    PointCloud<CLOUD_DYNAMIC> da = to_dynamic(a), db = to_dynamic(b);
+    CloudIndex<3> ia, ib;
+    CloudIndex<CLOUD_DYNAMIC> ja, jb;
+    t0 = bench_now();
+    ia.build(a);
+    ib.build(b);
+    t1 = bench_now();
+    ja.build(da);
+    jb.build(db);
+    t2 = bench_now();
+    printf("三维扫描 %d 点：建索引 %.1f ms（编译期维数） / %.1f ms（运行时维数）\n", SCAN_POINTS, (t1 - t0) * 1e3,
+           (t2 - t1) * 1e3);
+    t0 = bench_now();
+    h3 = cloud_hausdorff(ia, ib);
+    t1 = bench_now();
+    double hd = cloud_hausdorff(ja, jb);
+    t2 = bench_now();
+    printf("  距离 %.6f（%.1f ms，编译期维数），%.6f（%.1f ms，运行时维数）\n", h3, (t1 - t0) * 1e3, hd,
+           (t2 - t1) * 1e3);
+    printf("  包围盒下界 %.6f\n", cloud_lower_bound(ia, ib));
+
+    // 高维特征向量
+    PointCloud<CLOUD_DYNAMIC> fa(FEATURE_DIM), fb(FEATURE_DIM);
+    feature_set(&fa, FEATURE_POINTS, 3);
+    feature_set(&fb, FEATURE_POINTS, 4);
+    t0 = bench_now();
+    ref = brute_hausdorff(fa, fb);
+    t1 = bench_now();
+    hd = cloud_hausdorff(fa, fb);
+    t2 = bench_now();
+    printf("%d 维特征 %d 点：暴力 %.6f（%.1f ms），索引 %.6f（%.1f ms）\n", FEATURE_DIM, FEATURE_POINTS, ref,
+           (t1 - t0) * 1e3, hd, (t2 - t1) * 1e3);
+    return 0;
+}
@@ -0,0 +1,339 @@
+/**
+ * @Descripttion: 批量 Hausdorff 距离：按清单读入成对的点集文件，读取解析、重采样、建索引、求距离四级流水线并行，结果写成 CSV 或二进制表
+ * @filename: 批量Hausdorff.cpp
+ * @Author: 王春博
+ * @Date: 2026.10.19
+ * @Version: V1.0
+ *
+ * 用法：批量Hausdorff 清单文件 [--csv 输出] [--binary 输出] [--resample 最大点数]
+ *                      [--threads 读取,重采样,索引,距离] [--queue 队列容量]
+ * 清单每行一对：“文件A 文件B”为两个逐行坐标文件（random_set 格式，维数取第一行的数的个数）；
+ * 只有一个文件时按 in.txt 格式读取其中先后两组平面点。空行与 # 开头的行忽略。
+ * 各级之间为有界队列，文件读取与解析在自己的线程里进行，与索引、距离计算重叠。
+ * 结果按清单顺序输出：CSV 每行“序号,A 点数,B 点数,维数,距离,状态”；二进制为文件头 "NHAUS01\0" 加若干 32 字节的 BatchRecord。
+ * 状态非 0 时距离为 nan。重采样按等步长抽取，点数超过上限的点集只保留不超过上限的点，结果为近似值。
+ * 清单读取只领先已写出的结果至多一个重排窗口（各队列容量与线程数之和），慢任务后面等待写出的结果不会无限堆积。
+ */
+
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <cmath>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../common/bench.h"
+#include "../common/pipeline.hpp"
+#include "point_cloud.hpp"
+
+#define BATCH_OK 0
+#define BATCH_READ_ERROR 1     // 文件无法打开或读取
+#define BATCH_PARSE_ERROR 2    // 格式错误或点集为空
+#define BATCH_DIM_MISMATCH 3   // 两个点集维数不同
+#define BATCH_NO_MEMORY 4
+
+#define BATCH_QUEUE 64  // 默认队列容量
+
+typedef PointCloud<CLOUD_DYNAMIC> Cloud;
+
+struct Job {
+    long index;
+    std::string path_a, path_b;  // path_b 为空时 path_a 是 in.txt 格式
+    Cloud a{2}, b{2};
+    CloudIndex<CLOUD_DYNAMIC> ia, ib;
+    int count_a = 0, count_b = 0;  // 重采样前的点数
+    double distance = NAN;
+    int status = BATCH_OK;
+};
+typedef std::unique_ptr<Job> JobPtr;
+
+struct BatchRecord {
+    int64_t index;
+    int32_t count_a, count_b;
+    double distance;
+    int32_t status;
+    int32_t dim;
+};
+
+struct Options {
+    const char *manifest = nullptr;
+    const char *csv = nullptr;
+    const char *binary = nullptr;
+    int resample = 0;
+    int threads[4] = {2, 1, 2, 0};
+    int queue = BATCH_QUEUE;
+};
+
+// 读入整个文件，返回读到的字节数，失败返回 -1
+static long read_file(const std::string &path, std::string *out) {
+    FILE *f = fopen(path.c_str(), "rb");
+    if (f == nullptr) return -1;
+    out->clear();
+    char chunk[1 << 16];
+    size_t got;
+    while ((got = fread(chunk, 1, sizeof(chunk), f)) > 0) out->append(chunk, got);
+    int failed = ferror(f);
+    fclose(f);
+    return failed ? -1 : (long) out->size();
+}
+
+// 逐行坐标格式：第一行的数的个数为维数，其后所有数按维数分组
+static int parse_rows(const char *s, Cloud *c) {
+    while (*s == ' ' || *s == '\t' || *s == '\r' || *s == '\n') s++;
+    int dim = 0;
+    for (const char *p = s; *p != '\0' && *p != '\n';) {
+        char *end;
+        strtod(p, &end);
+        if (end == p) break;
+        dim++;
+        p = end;
+        while (*p == ' ' || *p == '\t' || *p == '\r') p++;
+    }
+    if (dim == 0) return BATCH_PARSE_ERROR;
+    *c = Cloud(dim);
+    std::vector<double> point(dim);
+    int k = 0;
+    for (;;) {
+        char *end;
+        double v = strtod(s, &end);
+        if (end == s) break;
+        s = end;
+        point[k++] = v;
+        if (k == dim) {
+            c->push(point.data());
+            k = 0;
+        }
+    }
+    while (*s == ' ' || *s == '\t' || *s == '\r' || *s == '\n') s++;
+    return k == 0 && *s == '\0' ? BATCH_OK : BATCH_PARSE_ERROR;
+}
+
+// in.txt 格式的一组：点数 n，随后 n 个平面点；点数必须是独立的整数（"2.08" 这类坐标不算），否则返回 nullptr
+static const char *parse_counted(const char *s, Cloud *c) {
+    char *end;
+    long n = strtol(s, &end, 10);
+    if (end == s || n <= 0 || (*end != '\0' && !isspace((unsigned char) *end))) return nullptr;
+    s = end;
+    *c = Cloud(2);
+    c->reserve((int) n);
+    for (long i = 0; i < n; i++) {
+        double p[2];
+        for (int d = 0; d < 2; d++) {
+            p[d] = strtod(s, &end);
+            if (end == s) return nullptr;
+            s = end;
+        }
+        c->push(p);
+    }
+    return s;
+}
+
+// 第一级：读取并解析
+static bool stage_read(Job &job, StageCounter &counter) {
+    std::string text;
+    long bytes = read_file(job.path_a, &text);
+    if (bytes < 0) {
+        job.status = BATCH_READ_ERROR;
+        return true;
+    }
+    counter.bytes += bytes;
+    try {
+        if (job.path_b.empty()) {
+            const char *rest = parse_counted(text.c_str(), &job.a);
+            if (rest == nullptr || parse_counted(rest, &job.b) == nullptr) job.status = BATCH_PARSE_ERROR;
+        } else {
+            job.status = parse_rows(text.c_str(), &job.a);
+            bytes = job.status == BATCH_OK ? read_file(job.path_b, &text) : 0;
+            if (bytes < 0) {
+                job.status = BATCH_READ_ERROR;
+                return true;
+            }
+            counter.bytes += bytes;
+            if (job.status == BATCH_OK) job.status = parse_rows(text.c_str(), &job.b);
+        }
+    } catch (const std::bad_alloc &) {
+        job.status = BATCH_NO_MEMORY;
+    }
+    if (job.status == BATCH_OK && job.a.dim() != job.b.dim()) job.status = BATCH_DIM_MISMATCH;
+    job.count_a = job.a.size();
+    job.count_b = job.b.size();
+    return true;
+}
+
+// 等步长抽取，使点数不超过 max_points
+static void resample(Cloud *c, int max_points) {
+    if (max_points <= 0 || c->size() <= max_points) return;
+    int stride = (c->size() + max_points - 1) / max_points;
+    Cloud r(c->dim());
+    std::vector<double> p(c->dim());
+    r.reserve(c->size() / stride + 1);
+    for (int i = 0; i < c->size(); i += stride) {
+        for (int d = 0; d < c->dim(); d++) p[d] = c->at(i, d);
+        r.push(p.data());
+    }
+    *c = std::move(r);
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr, "用法：%s 清单文件 [--csv 输出] [--binary 输出] [--resample 最大点数] "
+                    "[--threads 读取,重采样,索引,距离] [--queue 容量]\n", prog);
+}
+
+static int parse_options(int argc, char *argv[], Options *opt) {
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (strcmp(arg, "--csv") == 0 && has_value) {
+            opt->csv = argv[++i];
+        } else if (strcmp(arg, "--binary") == 0 && has_value) {
+            opt->binary = argv[++i];
+        } else if (strcmp(arg, "--resample") == 0 && has_value) {
+            opt->resample = atoi(argv[++i]);
+        } else if (strcmp(arg, "--queue") == 0 && has_value) {
+            opt->queue = atoi(argv[++i]);
+        } else if (strcmp(arg, "--threads") == 0 && has_value) {
+            if (sscanf(argv[++i], "%d,%d,%d,%d", &opt->threads[0], &opt->threads[1], &opt->threads[2],
+                       &opt->threads[3]) != 4) {
+                return -1;
+            }
+        } else if (arg[0] != '-' && opt->manifest == nullptr) {
+            opt->manifest = arg;
+        } else {
+            return -1;
+        }
+    }
+    if (opt->threads[3] <= 0) {
+        int hw = (int) std::thread::hardware_concurrency();
+        opt->threads[3] = hw > 2 ? hw - 2 : 1;
+    }
+    return opt->manifest != nullptr ? 0 : -1;
+}
+
+int main(int argc, char *argv[]) {
+    Options opt;
+    if (parse_options(argc, argv, &opt) != 0) {
+        usage(argv[0]);
+        return 1;
+    }
+    FILE *manifest = fopen(opt.manifest, "r");
+    if (manifest == nullptr) {
+        perror(opt.manifest);
+        return 1;
+    }
+    FILE *csv = opt.csv != nullptr ? fopen(opt.csv, "w") : nullptr;
+    FILE *binary = opt.binary != nullptr ? fopen(opt.binary, "wb") : nullptr;
+    if ((opt.csv != nullptr && csv == nullptr) || (opt.binary != nullptr && binary == nullptr)) {
+        perror("输出文件");
+        return 1;
+    }
+    if (csv != nullptr) fprintf(csv, "index,count_a,count_b,dim,distance,status\n");
+    if (binary != nullptr) fwrite("NHAUS01", 1, 8, binary);
+
+    BoundedQueue<JobPtr> jobs(opt.queue), parsed(opt.queue), sampled(opt.queue), indexed(opt.queue), done(opt.queue);
+    StageCounter c_read("读取解析"), c_resample("重采样"), c_index("建索引"), c_distance("求距离");
+    double t0 = bench_now();
+
+    // 重排窗口：只发出序号小于 next + window 的任务，等待写出的结果最多 window 个
+    long window = 5L * opt.queue;
+    for (int t : opt.threads) window += t;
+    std::mutex order_mutex;
+    std::condition_variable order_advanced;
+    long next = 0;  // 下一个要写出的序号，由写出线程在 order_mutex 下推进
+
+    // 清单逐行生成任务，队列满或超出重排窗口时阻塞
+    std::thread feeder([&] {
+        char line[4096], a[2048], b[2048];
+        long index = 0;
+        while (fgets(line, sizeof(line), manifest) != nullptr) {
+            int fields = sscanf(line, "%2047s %2047s", a, b);
+            if (fields < 1 || a[0] == '#') continue;
+            {
+                std::unique_lock<std::mutex> lock(order_mutex);
+                order_advanced.wait(lock, [&] { return index < next + window; });
+            }
+            JobPtr job(new Job);
+            job->index = index++;
+            job->path_a = a;
+            if (fields == 2) job->path_b = b;
+            if (!jobs.push(std::move(job))) break;
+        }
+        jobs.close();
+    });
+
+    std::vector<std::thread> threads;
+    auto add = [&threads](std::vector<std::thread> pool) {
+        for (auto &t : pool) threads.push_back(std::move(t));
+    };
+    add(pipeline_stage(opt.threads[0], jobs, parsed, c_read, [&c_read](JobPtr &job) { return stage_read(*job, c_read); }));
+    add(pipeline_stage(opt.threads[1], parsed, sampled, c_resample, [&opt](JobPtr &job) {
+        if (job->status == BATCH_OK && opt.resample > 0) {
+            resample(&job->a, opt.resample);
+            resample(&job->b, opt.resample);
+        }
+        return true;
+    }));
+    add(pipeline_stage(opt.threads[2], sampled, indexed, c_index, [](JobPtr &job) {
+        if (job->status == BATCH_OK && (job->ia.build(job->a) != 0 || job->ib.build(job->b) != 0)) {
+            job->status = BATCH_NO_MEMORY;
+        }
+        job->a.clear();  // 建好索引后原始点不再需要
+        job->b.clear();
+        return true;
+    }));
+    add(pipeline_stage(opt.threads[3], indexed, done, c_distance, [](JobPtr &job) {
+        if (job->status == BATCH_OK) job->distance = cloud_hausdorff(job->ia, job->ib);
+        job->ia = CloudIndex<CLOUD_DYNAMIC>();
+        job->ib = CloudIndex<CLOUD_DYNAMIC>();
+        return true;
+    }));
+
+    // 结果可能乱序到达，按序号排队后依次写出
+    std::map<long, BatchRecord> pending;
+    long written = 0, failed = 0;
+    JobPtr job;
+    while (done.pop(job)) {
+        int dim = job->status == BATCH_OK || job->status == BATCH_DIM_MISMATCH ? job->a.dim() : 0;
+        BatchRecord r = {job->index, job->count_a, job->count_b, job->distance, job->status, dim};
+        failed += job->status != BATCH_OK;
+        pending[r.index] = r;
+        job.reset();
+        for (auto it = pending.begin(); it != pending.end() && it->first == written; it = pending.erase(it), written++) {
+            const BatchRecord &w = it->second;
+            if (csv != nullptr) {
+                fprintf(csv, "%ld,%d,%d,%d,%.17g,%d\n", (long) w.index, w.count_a, w.count_b, w.dim, w.distance,
+                        w.status);
+            }
+            if (binary != nullptr) fwrite(&w, sizeof(w), 1, binary);
+            if (csv == nullptr && binary == nullptr) {
+                printf("%ld: %d / %d 点，距离 %.6f，状态 %d\n", (long) w.index, w.count_a, w.count_b, w.distance, w.status);
+            }
+        }
+        {
+            std::lock_guard<std::mutex> lock(order_mutex);
+            next = written;
+        }
+        order_advanced.notify_one();
+    }
+    feeder.join();
+    for (auto &t : threads) t.join();
+    double wall = bench_now() - t0;
+    fclose(manifest);
+    if (csv != nullptr) fclose(csv);
+    if (binary != nullptr) fclose(binary);
+
+    fprintf(stderr, "%ld 对，失败 %ld 对，总耗时 %.3f s（%.1f 对/秒）\n", written, failed, wall, written / wall);
+    for (const StageCounter *c : {&c_read, &c_resample, &c_index, &c_distance}) {
+        double busy = c->busy_seconds();
+        fprintf(stderr, "  %-8s %2d 线程  %6ld 项  忙碌 %8.3f s  利用率 %5.1f%%  %8.1f 项/秒", c->name, c->threads,
+                c->items.load(), busy, 100.0 * busy / (wall * c->threads), busy > 0 ? c->items * c->threads / busy : 0.0);
+        if (c->bytes > 0) fprintf(stderr, "  %.1f MB/s", c->bytes / 1048576.0 / (busy / c->threads));
+        fprintf(stderr, "\n");
+    }
+    return failed > 0 ? 2 : 0;
+}
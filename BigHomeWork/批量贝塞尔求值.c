@@ -0,0 +1,115 @@
+/**
+ * @Descripttion: 批量贝塞尔曲线求值：与逐点 pow 的原始写法比较速度，与 de Casteljau 比较高次曲线的精度
+ * @filename: 批量贝塞尔求值.c
+ * @Author: 王春博
+ * @Date: 2026.10.19
+ * @Version: V1.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#include "../common/rng.h"
+#include "../common/bench.h"
+#include "bezier.h"
+
+#define CURVES 200000  // 批量求值的曲线条数
+#define DEGREE 3       // 批量曲线的次数
+#define SAMPLES 32     // 每条曲线的采样点数
+#define CHECK_SAMPLES 1000  // 高次曲线精度检验的采样点数
+#define SEED 20241015
+
+// 原 draw.c 的写法（次数已改正）：每个控制点、每个采样点都调用 pow 并重算二项式系数
+void bezier_curve_pow(const double *ctrl, int degree, int dim, int samples, double *out) {
+    for (int k = 0; k < samples; k++) {
+        double t = (double)k / (samples - 1);
+        for (int d = 0; d < dim; d++) {
+            out[d * samples + k] = 0.0;
+        }
+        for (int j = 0; j <= degree; j++) {
+            double binomial_coeff = 1;
+            for (int i = 0; i < j; i++) {
+                binomial_coeff *= (degree - i) / (i + 1.0);
+            }
+            for (int d = 0; d < dim; d++) {
+                out[d * samples + k] += binomial_coeff * pow(1 - t, degree - j) * pow(t, j) * ctrl[j * dim + d];
+            }
+        }
+    }
+}
+
+int main() {
+    const int dim = 2;
+    int *offset = (int *)malloc((CURVES + 1) * sizeof(int));
+    double *ctrl = (double *)malloc((size_t)CURVES * (DEGREE + 1) * dim * sizeof(double));
+    double *out = (double *)malloc((size_t)CURVES * dim * SAMPLES * sizeof(double));
+    double *ref = (double *)malloc((size_t)CURVES * dim * SAMPLES * sizeof(double));
+    if (offset == NULL || ctrl == NULL || out == NULL || ref == NULL) {
+        printf("内存分配失败\n");
+        free(offset);
+        free(ctrl);
+        free(out);
+        free(ref);
+        return -1;
+    }
+    Rng rng;
+    rng_init(&rng, SEED);
+    rng_fill_uniform(&rng, ctrl, (size_t)CURVES * (DEGREE + 1) * dim, 0, 4);
+    for (int c = 0; c <= CURVES; c++) {
+        offset[c] = c * (DEGREE + 1);
+    }
+    BezierSet set = {CURVES, dim, offset, ctrl};
+
+    double start = bench_now();
+    bezier_sample_uniform(&set, SAMPLES, out);
+    double t_batch = bench_now() - start;
+
+    start = bench_now();
+    for (int c = 0; c < CURVES; c++) {
+        bezier_curve_pow(ctrl + (size_t)c * (DEGREE + 1) * dim, DEGREE, dim, SAMPLES, ref + (size_t)c * dim * SAMPLES);
+    }
+    double t_pow = bench_now() - start;
+
+    double max_err = 0.0;
+    for (size_t i = 0; i < (size_t)CURVES * dim * SAMPLES; i++) {
+        max_err = fmax(max_err, fabs(out[i] - ref[i]));
+    }
+    double points = (double)CURVES * SAMPLES;
+    printf("%d 条 %d 次曲线，每条 %d 个采样点\n", CURVES, DEGREE, SAMPLES);
+    printf("  逐点 pow: %.3f 秒，%.1f M 点/秒\n", t_pow, points / t_pow / 1e6);
+    printf("  批量求值: %.3f 秒，%.1f M 点/秒，加速 %.1f 倍，最大差 %e\n",
+           t_batch, points / t_batch / 1e6, t_pow / t_batch, max_err);
+
+    free(offset);
+    free(ctrl);
+    free(out);
+    free(ref);
+
+    // 高次曲线：random_set1.txt 的 100 个点作为一条 99 次曲线的控制点，至少两个点才构成曲线
+    double high[100 * 2];
+    int count = bezier_read_control_points("BigHomeWork/random_set1.txt", high, 100);
+    if (count < 0) {
+        perror("无法打开文件 random_set1.txt");
+        return -1;
+    }
+    if (count < 2) {
+        printf("random_set1.txt 中只有 %d 个控制点，至少需要 2 个\n", count);
+        return -1;
+    }
+
+    double t[CHECK_SAMPLES], curve[2 * CHECK_SAMPLES], point[2], work[100 * 2];
+    for (int k = 0; k < CHECK_SAMPLES; k++) {
+        t[k] = (double)k / (CHECK_SAMPLES - 1);
+    }
+    bezier_eval(high, count - 1, dim, t, CHECK_SAMPLES, curve);
+    max_err = 0.0;
+    for (int k = 0; k < CHECK_SAMPLES; k++) {
+        bezier_de_casteljau(high, count - 1, dim, t[k], point, NULL, NULL, work);
+        max_err = fmax(max_err, fmax(fabs(point[0] - curve[k]), fabs(point[1] - curve[CHECK_SAMPLES + k])));
+    }
+    printf("%d 次曲线：与 de Casteljau 的最大差 %e\n", count - 1, max_err);
+    return 0;
+}
@@ -0,0 +1,131 @@
+/**
+ * @Descripttion: 折线/贝塞尔曲线之间的精确 Hausdorff 距离：线段 BVH + 分支定界，与顶点距离、密集采样比较
+ * @filename: 精确曲线距离.c
+ * @Author: 王春博
+ * @Date: 2026.10.19
+ * @Version: V1.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "../common/bench.h"
+#include "../common/rng.h"
+#include "bezier.h"
+#include "hausdorff.h"
+#include "segment_hausdorff.h"
+
+#define REFERENCE_POINTS 20000  // 采样参考值的点数
+#define TOL 1e-6                // 曲线距离的误差容限
+#define LARGE_VERTICES 200000   // 大规模折线的顶点数
+
+// 折线每段再均匀插入 per_segment - 1 个点，作为密集采样的参考
+void densify(const PointSet *line, int per_segment, PointSet *out) {
+    point_set_clear(out);
+    for (int i = 0; i + 1 < line->count; i++) {
+        for (int k = 0; k < per_segment; k++) {
+            double s = (double)k / per_segment;
+            point_set_push(out, line->x[i] + s * (line->x[i + 1] - line->x[i]), line->y[i] + s * (line->y[i + 1] - line->y[i]));
+        }
+    }
+    point_set_push(out, line->x[line->count - 1], line->y[line->count - 1]);
+}
+
+// 最远点在线段内部：顶点距离低估结果
+void polyline_case() {
+    PointSet a, b, da, db;
+    point_set_init(&a);
+    point_set_init(&b);
+    point_set_init(&da);
+    point_set_init(&db);
+    // 同一个三角形的三个顶点按不同顺序连成两条折线：顶点都落在对方折线上，
+    // 但 a 的底边中点 (5, 0) 离 b 为 5 / sqrt(2)
+    point_set_push(&a, 0, 0);
+    point_set_push(&a, 10, 0);
+    point_set_push(&a, 5, 5);
+    point_set_push(&b, 0, 0);
+    point_set_push(&b, 5, 5);
+    point_set_push(&b, 10, 0);
+
+    double vertex = hausdorff_distance_polylines(&a, &b);
+    double exact = segment_hausdorff(&a, &b, 1e-12);
+    densify(&a, 1000, &da);
+    densify(&b, 1000, &db);
+    double dense = hausdorff_distance_polylines(&da, &db);
+    printf("三角形折线: 顶点到折线 %.9f，精确 %.9f，密集插点 %.9f，理论值 %.9f\n", vertex, exact, dense, 5 / sqrt(2));
+
+    point_set_free(&a);
+    point_set_free(&b);
+    point_set_free(&da);
+    point_set_free(&db);
+}
+
+void bezier_case(const char *title, const double *ctrl_a, int size_a, const double *ctrl_b, int size_b) {
+    PointSet ra, rb;
+    point_set_init(&ra);
+    point_set_init(&rb);
+    double t0 = bench_now();
+    if (bezier_sample_points(ctrl_a, size_a - 1, REFERENCE_POINTS, &ra) != 0 ||
+        bezier_sample_points(ctrl_b, size_b - 1, REFERENCE_POINTS, &rb) != 0) {
+        printf("%s: 采样内存不足\n", title);
+        point_set_free(&ra);
+        point_set_free(&rb);
+        return;
+    }
+    double reference = hausdorff_distance_polylines(&ra, &rb);
+    double t1 = bench_now();
+    double exact = bezier_hausdorff(ctrl_a, size_a - 1, ctrl_b, size_b - 1, TOL);
+    double t2 = bench_now();
+    printf("%s: 采样 %d 点 %.9f（%.1f ms），自适应 + 精确 %.9f（%.1f ms），差 %.2e\n", title, REFERENCE_POINTS,
+           reference, (t1 - t0) * 1e3, exact, (t2 - t1) * 1e3, fabs(exact - reference));
+    point_set_free(&ra);
+    point_set_free(&rb);
+}
+
+// 大规模折线：BVH 剪枝与逐段扫描的耗时
+void large_case() {
+    PointSet a, b;
+    point_set_init(&a);
+    point_set_init(&b);
+    Rng rng;
+    rng_init(&rng, 2026);
+    for (int i = 0; i < LARGE_VERTICES; i++) {
+        double s = 2 * M_PI * i / (LARGE_VERTICES - 1);
+        point_set_push(&a, cos(s) * (1 + 0.05 * sin(37 * s)), sin(s) * (1 + 0.05 * sin(37 * s)));
+        point_set_push(&b, cos(s) * (1 + 0.04 * cos(23 * s)) + rng_uniform_range(&rng, 0.0, 1e-3), sin(s) * (1 + 0.04 * cos(23 * s)));
+    }
+    double t0 = bench_now();
+    double exact = segment_hausdorff(&a, &b, 1e-12);
+    double t1 = bench_now();
+    int n = LARGE_VERTICES / 20;  // 逐段扫描为平方复杂度，只取一部分顶点估算
+    PointSet sa = a;
+    sa.count = n;
+    double t2 = bench_now();
+    hausdorff_points_to_polyline_sq(&sa, &b);
+    double t3 = bench_now();
+    double brute = (t3 - t2) * 20 * 2;  // 折算到全部顶点、双向
+    printf("%d 顶点折线: 精确 %.9f，BVH 分支定界 %.1f ms；逐段扫描仅顶点约 %.1f ms\n", LARGE_VERTICES, exact,
+           (t1 - t0) * 1e3, brute * 1e3);
+    point_set_free(&a);
+    point_set_free(&b);
+}
+
+int main() {
+    polyline_case();
+
+    double curve_a[] = {0, 0, 1, 2, 3, 3, 4, 0};
+    double curve_b[] = {0, 0, 1, 1, 3, 2, 4, 0};
+    bezier_case("三次曲线 A/B", curve_a, 4, curve_b, 4);
+
+    double high_a[200], high_b[200];
+    int na = bezier_read_control_points("BigHomeWork/random_set1.txt", high_a, 100);
+    int nb = bezier_read_control_points("BigHomeWork/random_set2.txt", high_b, 100);
+    if (na < 0 || nb < 0) {
+        perror("BigHomeWork/random_set");
+    } else if (na > 1 && nb > 1) {
+        bezier_case("99 次曲线", high_a, na, high_b, nb);
+    }
+
+    large_case();
+    return 0;
+}
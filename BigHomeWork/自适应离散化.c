@@ -0,0 +1,75 @@
+/**
+ * @Descripttion: 贝塞尔曲线自适应离散化：按弦高误差细分，点直接写入 Hausdorff 引擎的点集，与固定 100 点采样比较
+ * @filename: 自适应离散化.c
+ * @Author: 王春博
+ * @Date: 2026.10.19
+ * @Version: V1.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "bezier.h"
+#include "hausdorff.h"
+
+#define UNIFORM_POINTS 100   // draw.c 原来的固定采样点数
+#define REFERENCE_POINTS 20000  // 参考值的采样点数
+#define TOL 1e-3             // 弦高误差容限
+
+void compare(const char *title, const double *ctrl_a, int size_a, const double *ctrl_b, int size_b) {
+    PointSet ua, ub, fa, fb, ra, rb;
+    point_set_init(&ua);
+    point_set_init(&ub);
+    point_set_init(&fa);
+    point_set_init(&fb);
+    point_set_init(&ra);
+    point_set_init(&rb);
+
+    int status = bezier_sample_points(ctrl_a, size_a - 1, REFERENCE_POINTS, &ra);
+    if (status == 0) status = bezier_sample_points(ctrl_b, size_b - 1, REFERENCE_POINTS, &rb);
+    if (status == 0) status = bezier_sample_points(ctrl_a, size_a - 1, UNIFORM_POINTS, &ua);
+    if (status == 0) status = bezier_sample_points(ctrl_b, size_b - 1, UNIFORM_POINTS, &ub);
+    if (status == 0) status = bezier_flatten(ctrl_a, size_a - 1, TOL, &fa);
+    if (status == 0) status = bezier_flatten(ctrl_b, size_b - 1, TOL, &fb);
+    if (status != 0) {
+        printf("%s: 离散化内存不足\n", title);
+    } else {
+        // 自适应结果量的是顶点到对方折线的距离，是折线间距离的下界，与参考值之差还包含这部分低估
+        double reference = hausdorff_distance_sets(&ra, &rb);
+        double uniform = hausdorff_distance_sets(&ua, &ub);
+        double adaptive = hausdorff_distance_polylines(&fa, &fb);
+        printf("%s: 参考值 %.6f\n", title, reference);
+        printf("  固定采样 %4d + %4d 点: %.6f，误差 %.2e\n", ua.count, ub.count, uniform, fabs(uniform - reference));
+        printf("  自适应   %4d + %4d 点: %.6f，误差 %.2e\n", fa.count, fb.count, adaptive, fabs(adaptive - reference));
+    }
+
+    point_set_free(&ua);
+    point_set_free(&ub);
+    point_set_free(&fa);
+    point_set_free(&fb);
+    point_set_free(&ra);
+    point_set_free(&rb);
+}
+
+int main() {
+    // draw.c 中的两条三次曲线
+    double curve_a[] = {0, 0, 1, 2, 3, 3, 4, 0};
+    double curve_b[] = {0, 0, 1, 1, 3, 2, 4, 0};
+    compare("三次曲线 A/B", curve_a, 4, curve_b, 4);
+
+    // 近似直线的曲线：大部分平直，只有一端轻微弯曲
+    double straight_a[] = {0, 0, 1, 0.001, 2, 0, 3, 0.002, 4, 0.05, 4.2, 0.3};
+    double straight_b[] = {0, 0.01, 1, 0.01, 2, 0.012, 3, 0.01, 4, 0.06, 4.2, 0.25};
+    compare("近似直线", straight_a, 6, straight_b, 6);
+
+    // random_set 中的 100 个点作为 99 次曲线的控制点
+    double high_a[200], high_b[200];
+    int na = bezier_read_control_points("BigHomeWork/random_set1.txt", high_a, 100);
+    int nb = bezier_read_control_points("BigHomeWork/random_set2.txt", high_b, 100);
+    if (na < 0 || nb < 0) {
+        perror("BigHomeWork/random_set");
+    } else if (na > 1 && nb > 1) {
+        compare("99 次曲线", high_a, na, high_b, nb);
+    }
+    return 0;
+}
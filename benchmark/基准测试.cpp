@@ -0,0 +1,593 @@
+/**
+ * @Descripttion: 统一基准测试：覆盖稠密/带状/稀疏求解、雅克比迭代、Hausdorff 与 Fréchet、求积、求根、曲线求值等核心算法，
+ *                墙钟计时 + 预热与重复，输出 JSON 并可与基线比较，用于发现性能回归
+ * @filename: 基准测试.cpp
+ * @Author: 王春博
+ * @Date: 2026.10.19
+ * @Version: V1.0
+ *
+ * 用法：benchmark [--filter 子串] [--scale 倍数] [--warmup 次数] [--reps 次数]
+ *                 [--json 输出文件] [--baseline 基线文件] [--tolerance 比例] [--list]
+ * 各测试的默认规模乘以 --scale（至少为 1）；中位数慢于基线 (1 + tolerance) 倍的记为回归，此时返回 1。
+ * 规模的含义由各测试自定：矩阵阶数、点数、方程个数等；flops/bytes 为每次调用的估计量，
+ * 带剪枝或早停的算法工作量取决于数据，flops 记为 0。
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#include "../common/bench.h"
+#include "../common/rng.h"
+#include "../common/sum.h"
+#include "../common/banded.h"
+#include "../common/trisolve.h"
+#include "../common/roots.hpp"
+#include "../common/poly.hpp"
+#include "../第二周/quadratic_batch.h"
+#include "../第三周/ellipse_distance.h"
+#include "../第四周/lu.hpp"
+#include "../第四周/mixed_refine.hpp"
+#include "../第五周/jacobi.h"
+#include "../第八次作业/least_squares.hpp"
+#include "../第九次作业/chebyshev.hpp"
+#include "../第十次作业/simpson.h"
+#include "../第十次作业/cubature.hpp"
+#include "../BigHomeWork/bezier.h"
+#include "../BigHomeWork/hausdorff.h"
+#include "../BigHomeWork/segment_hausdorff.h"
+#include "../BigHomeWork/hausdorff_matrix.h"
+#include "../BigHomeWork/point_cloud.hpp"
+#include "../BigHomeWork/frechet.h"
+
+#define BENCH_MAX_RESULTS 256  // 一次运行的结果条数上限
+#define BENCH_SEED 20261019ULL
+
+// 一次测量：run 为被测调用，flops/bytes 为每次调用的估计量；准备数据失败时返回空的 run，该项跳过
+struct Case {
+    std::function<void()> run;
+    double flops;
+    double bytes;
+};
+
+struct Kernel {
+    const char *name;
+    std::vector<long> sizes;
+    std::function<Case(long)> make;
+};
+
+// 防止结果被优化掉
+static volatile double bench_sink;
+
+static std::vector<double> random_vector(long n, double lo, double hi, uint64_t seed) {
+    std::vector<double> v(n);
+    Rng r;
+    rng_init(&r, seed);
+    rng_fill_uniform(&r, v.data(), (size_t) n, lo, hi);
+    return v;
+}
+
+// 对角占优的随机稠密矩阵（行优先）
+static std::vector<double> random_matrix(int n, uint64_t seed) {
+    std::vector<double> a = random_vector((long) n * n, -1.0, 1.0, seed);
+    for (int i = 0; i < n; i++) a[(long) i * n + i] += n;
+    return a;
+}
+
+// 沿正弦曲线的带噪点列
+static void noisy_curve(PointSet *s, long n, double phase, uint64_t seed) {
+    Rng r;
+    rng_init(&r, seed);
+    point_set_init(s);
+    point_set_reserve(s, (int) n);
+    for (long i = 0; i < n; i++) {
+        double t = 10.0 * i / (n > 1 ? n - 1 : 1);
+        point_set_push(s, t, sin(t + phase) + 0.01 * rng_uniform(&r));
+    }
+}
+
+struct PointSetPair {
+    PointSet a, b;
+    ~PointSetPair() {
+        point_set_free(&a);
+        point_set_free(&b);
+    }
+};
+
+static std::shared_ptr<PointSetPair> curve_pair(long n) {
+    auto p = std::make_shared<PointSetPair>();
+    noisy_curve(&p->a, n, 0.0, BENCH_SEED);
+    noisy_curve(&p->b, n * 3 / 4 + 1, 0.05, BENCH_SEED + 1);
+    return p;
+}
+
+// 求根测试方程 x^3 + x - c = 0，在 [-10, 10] 上有唯一根
+struct CubicValue {
+    double c;
+    double operator()(double x) const { return x * x * x + x - c; }
+};
+struct CubicDerivative {
+    double c;
+    void eval(double x, double &f, double &df) const {
+        f = x * x * x + x - c;
+        df = 3 * x * x + 1;
+    }
+};
+
+static std::vector<Kernel> make_kernels() {
+    std::vector<Kernel> k;
+
+    // ---------------- 求和 ----------------
+    k.push_back({"sum/blocked", {1L << 22}, [](long n) {
+        auto x = std::make_shared<std::vector<double>>(random_vector(n, -1.0, 1.0, BENCH_SEED));
+        return Case{[x] { bench_sink = sum_blocked(x->data(), x->size()); }, 4.0 * n, 8.0 * n};
+    }});
+    k.push_back({"sum/reproducible", {1L << 22}, [](long n) {
+        auto x = std::make_shared<std::vector<double>>(random_vector(n, -1.0, 1.0, BENCH_SEED));
+        return Case{[x] { bench_sink = sum_reproducible(x->data(), x->size()); }, 4.0 * n, 8.0 * n};
+    }});
+
+    // ---------------- 稠密求解 ----------------
+    k.push_back({"dense/lu_factor", {256, 512}, [](long n) {
+        auto a0 = std::make_shared<std::vector<double>>(random_matrix((int) n, BENCH_SEED));
+        auto a = std::make_shared<std::vector<double>>(a0->size());
+        auto perm = std::make_shared<std::vector<int>>(n);
+        return Case{[=] {
+                        *a = *a0;
+                        lu_factor(a->data(), (int) n, (int) n, perm->data());
+                    },
+                    2.0 / 3.0 * n * n * n, 8.0 * n * n};
+    }});
+    k.push_back({"dense/lu_solve", {1024}, [](long n) {
+        auto a = std::make_shared<std::vector<double>>(random_matrix((int) n, BENCH_SEED));
+        auto perm = std::make_shared<std::vector<int>>(n);
+        lu_factor(a->data(), (int) n, (int) n, perm->data());
+        auto b0 = std::make_shared<std::vector<double>>(random_vector(n, -1.0, 1.0, BENCH_SEED + 1));
+        auto b = std::make_shared<std::vector<double>>(n);
+        return Case{[=] {
+                        *b = *b0;
+                        lu_solve(a->data(), (int) n, (int) n, perm->data(), b->data());
+                    },
+                    2.0 * n * n, 8.0 * n * n};
+    }});
+    k.push_back({"dense/mixed_refine", {512}, [](long n) {
+        auto a = std::make_shared<std::vector<double>>(random_matrix((int) n, BENCH_SEED));
+        auto b = std::make_shared<std::vector<double>>(random_vector(n, -1.0, 1.0, BENCH_SEED + 1));
+        auto x = std::make_shared<std::vector<double>>(n);
+        return Case{[=] { mixed_precision_solve(a->data(), (int) n, (int) n, b->data(), x->data()); },
+                    2.0 / 3.0 * n * n * n, 8.0 * n * n};
+    }});
+    k.push_back({"dense/trsv_upper", {2048}, [](long n) {
+        auto a = std::make_shared<std::vector<double>>(random_matrix((int) n, BENCH_SEED));
+        auto rows = std::make_shared<std::vector<double *>>(n);
+        for (long i = 0; i < n; i++) (*rows)[i] = a->data() + i * n;
+        auto b0 = std::make_shared<std::vector<double>>(random_vector(n, -1.0, 1.0, BENCH_SEED + 1));
+        auto b = std::make_shared<std::vector<double>>(n);
+        // rows 指向 a 的存储，a 须一并捕获
+        return Case{[a, rows, b0, b, n] {
+                        *b = *b0;
+                        trsv_upper(rows->data(), (int) n, b->data());
+                    },
+                    1.0 * n * n, 4.0 * n * n};
+    }});
+
+    // ---------------- 带状与稀疏求解 ----------------
+    k.push_back({"band/lu_kl3_ku3", {200000}, [](long n) {
+        const int kl = 3, ku = 3;
+        auto m = std::shared_ptr<BandMatrix>(new BandMatrix, [](BandMatrix *p) {
+            band_free(p);
+            delete p;
+        });
+        if (band_alloc(m.get(), (int) n, kl, ku) != 0) return Case{};
+        auto ab0 = std::make_shared<std::vector<double>>((size_t) n * m->width, 0.0);
+        Rng r;
+        rng_init(&r, BENCH_SEED);
+        for (long i = 0; i < n; i++) {
+            for (long j = i - kl; j <= i + ku; j++) {
+                if (j >= 0 && j < n) (*ab0)[i * m->width + (j - i + kl)] = i == j ? 8.0 : rng_uniform_range(&r, -1, 1);
+            }
+        }
+        auto b0 = std::make_shared<std::vector<double>>(random_vector(n, -1.0, 1.0, BENCH_SEED + 1));
+        auto b = std::make_shared<std::vector<double>>(n);
+        return Case{[=] {
+                        std::memcpy(m->ab, ab0->data(), ab0->size() * sizeof(double));
+                        *b = *b0;
+                        band_lu_factor(m.get());
+                        band_lu_solve(m.get(), b->data());
+                    },
+                    2.0 * n * kl * (kl + ku + 1) + 2.0 * n * (2 * kl + ku), 16.0 * n * m->width};
+    }});
+    k.push_back({"band/thomas", {1L << 20}, [](long n) {
+        auto a = std::make_shared<std::vector<double>>(random_vector(n, -1.0, 1.0, BENCH_SEED));
+        auto c = std::make_shared<std::vector<double>>(random_vector(n, -1.0, 1.0, BENCH_SEED + 1));
+        auto d = std::make_shared<std::vector<double>>(random_vector(n, 4.0, 5.0, BENCH_SEED + 2));
+        auto b0 = std::make_shared<std::vector<double>>(random_vector(n, -1.0, 1.0, BENCH_SEED + 3));
+        auto b = std::make_shared<std::vector<double>>(n);
+        auto work = std::make_shared<std::vector<double>>(n);
+        return Case{[=] {
+                        *b = *b0;
+                        thomas_solve(a->data(), d->data(), c->data(), b->data(), (int) n, work->data());
+                    },
+                    8.0 * n, 56.0 * n};
+    }});
+    k.push_back({"sparse/tri_level_solve", {200000}, [](long n) {
+        // 随机稀疏下三角阵：每行 8 个非零元落在前 1000 行内
+        auto m = std::shared_ptr<CsrMatrix>(new CsrMatrix, [](CsrMatrix *p) {
+            csr_free(p);
+            delete p;
+        });
+        const int per_row = 8;
+        m->n = (int) n;
+        m->row_ptr = (int *) malloc((size_t) (n + 1) * sizeof(int));
+        m->col = (int *) malloc((size_t) n * (per_row + 1) * sizeof(int));
+        m->val = (double *) malloc((size_t) n * (per_row + 1) * sizeof(double));
+        if (m->row_ptr == NULL || m->col == NULL || m->val == NULL) return Case{};
+        Rng r;
+        rng_init(&r, BENCH_SEED);
+        long nnz = 0;
+        for (long i = 0; i < n; i++) {
+            m->row_ptr[i] = (int) nnz;
+            for (int t = 0; t < per_row && i > 0; t++) {
+                long lo = i > 1000 ? i - 1000 : 0;
+                m->col[nnz] = (int) (lo + (long) rng_below(&r, (uint64_t) (i - lo)));
+                m->val[nnz++] = rng_uniform_range(&r, -0.1, 0.1);
+            }
+            m->col[nnz] = (int) i;
+            m->val[nnz++] = 1.0;
+        }
+        m->row_ptr[n] = (int) nnz;
+        auto s = std::shared_ptr<TriSchedule>(new TriSchedule, [](TriSchedule *p) {
+            tri_schedule_free(p);
+            delete p;
+        });
+        if (tri_schedule_build(s.get(), m.get(), 0) != 0) return Case{};
+        auto b0 = std::make_shared<std::vector<double>>(random_vector(n, -1.0, 1.0, BENCH_SEED + 1));
+        auto b = std::make_shared<std::vector<double>>(n);
+        return Case{[=] {
+                        *b = *b0;
+                        tri_schedule_solve(s.get(), m.get(), b->data());
+                    },
+                    2.0 * nnz, 12.0 * nnz + 16.0 * n};
+    }});
+
+    // ---------------- 迭代法 ----------------
+    k.push_back({"iterative/jacobi", {1000}, [](long n) {
+        // 对角占优稠密矩阵，tol = 0 使每次调用固定迭代 sweeps 次
+        const int sweeps = 10;
+        auto a = std::make_shared<std::vector<double>>(random_matrix((int) n, BENCH_SEED));
+        auto rows = std::make_shared<std::vector<double *>>(n);
+        for (long i = 0; i < n; i++) (*rows)[i] = a->data() + i * n;
+        auto b = std::make_shared<std::vector<double>>(random_vector(n, -1.0, 1.0, BENCH_SEED + 1));
+        auto x = std::make_shared<std::vector<double>>(n);
+        auto x_new = std::make_shared<std::vector<double>>(n);
+        return Case{[a, rows, b, x, x_new, n] {
+                        std::fill(x->begin(), x->end(), 0.0);
+                        jacobi_iterate(rows->data(), b->data(), x->data(), x_new->data(), (int) n, 0.0, sweeps);
+                    },
+                    sweeps * 2.0 * n * n, sweeps * 8.0 * n * n};
+    }});
+
+    // ---------------- Hausdorff 与 Fréchet ----------------
+    k.push_back({"hausdorff/sets", {4000}, [](long n) {
+        auto p = curve_pair(n);
+        return Case{[p] { bench_sink = hausdorff_distance_sets(&p->a, &p->b); }, 0.0, 16.0 * n};
+    }});
+    k.push_back({"hausdorff/polylines", {2000}, [](long n) {
+        auto p = curve_pair(n);
+        return Case{[p] { bench_sink = hausdorff_distance_polylines(&p->a, &p->b); }, 0.0, 16.0 * n};
+    }});
+    k.push_back({"hausdorff/segment_exact", {50000}, [](long n) {
+        auto p = curve_pair(n);
+        return Case{[p] { bench_sink = segment_hausdorff(&p->a, &p->b, 1e-12); }, 0.0, 16.0 * n};
+    }});
+    k.push_back({"hausdorff/matrix_dense", {128}, [](long n) {
+        // n 条曲线，每条 256 点
+        auto sets = std::shared_ptr<std::vector<PointSet>>(new std::vector<PointSet>(n), [](std::vector<PointSet> *v) {
+            for (PointSet &s : *v) point_set_free(&s);
+            delete v;
+        });
+        for (long c = 0; c < n; c++) noisy_curve(&(*sets)[c], 256, 0.1 * c, BENCH_SEED + c);
+        auto out = std::make_shared<std::vector<double>>((size_t) n * n);
+        return Case{[=] { hausdorff_matrix_dense(sets->data(), (int) n, out->data()); }, 0.0, 16.0 * 256 * n};
+    }});
+    k.push_back({"hausdorff/cloud3d", {50000}, [](long n) {
+        // 两组三维点：同一起伏曲面上的随机采样，第二组整体抬高 0.05；计时含建索引。
+        // 点云索引只测三维，平面点集的索引以 hausdorff_matrix.h 为准（见 hausdorff/matrix_dense）
+        auto p = std::make_shared<std::vector<PointCloud<3>>>(2);
+        Rng r;
+        rng_init(&r, BENCH_SEED);
+        for (int s = 0; s < 2; s++) {
+            for (long i = 0; i < n; i++) {
+                double q[3] = {rng_uniform_range(&r, 0, 100), rng_uniform_range(&r, 0, 100), 0.0};
+                q[2] = 2 * sin(0.1 * q[0]) * cos(0.07 * q[1]) + 0.05 * s;
+                (*p)[s].push(q);
+            }
+        }
+        return Case{[p] { bench_sink = cloud_hausdorff((*p)[0], (*p)[1]); }, 0.0, 48.0 * n};
+    }});
+    k.push_back({"frechet/distance", {4000}, [](long n) {
+        auto p = curve_pair(n);
+        double cells = (double) p->a.count * p->b.count;
+        return Case{[p] { bench_sink = frechet_distance(&p->a, &p->b); }, 8.0 * cells, 0.0};
+    }});
+    k.push_back({"frechet/decide", {20000}, [](long n) {
+        auto p = curve_pair(n);
+        double eps = frechet_distance(&p->a, &p->b);
+        return Case{[p, eps] { bench_sink = frechet_decide(&p->a, &p->b, eps); }, 0.0, 0.0};
+    }});
+
+    // ---------------- 求积 ----------------
+    k.push_back({"quadrature/simpson", {1L << 20}, [](long n) {
+        // 规模为最后一轮的子区间数；eps = 0 使区间数一直加倍到 n
+        int rounds = 0;
+        while ((1L << rounds) < n) rounds++;
+        return Case{[rounds] {
+                        bench_sink = composite_simpson([](double x) { return sin(x); }, 0.0, M_PI, 0.0, rounds, nullptr);
+                    },
+                    0.0, 0.0};
+    }});
+    k.push_back({"quadrature/adaptive_gauss_3d", {200000}, [](long n) {
+        // 规模为最大求值次数
+        return Case{[n] {
+                        double lo[3] = {0, 0, 0}, hi[3] = {1, 1, 1};
+                        auto f = [](const double *x) {
+                            double r2 = 0.0;
+                            for (int d = 0; d < 3; d++) r2 += (x[d] - 0.5) * (x[d] - 0.5);
+                            return exp(-100 * r2);
+                        };
+                        bench_sink = adaptive_cubature(f, 3, lo, hi, 1e-12, 1e-12, n).value;
+                    },
+                    0.0, 0.0};
+    }});
+    k.push_back({"quadrature/sobol_8d", {1L << 16}, [](long n) {
+        return Case{[n] {
+                        double lo[8] = {0}, hi[8] = {1, 1, 1, 1, 1, 1, 1, 1};
+                        auto f = [](const double *x) {
+                            double p = 1.0;
+                            for (int d = 0; d < 8; d++) p *= cos(x[d]);
+                            return p;
+                        };
+                        bench_sink = sobol_cubature(f, 8, lo, hi, n).value;
+                    },
+                    0.0, 0.0};
+    }});
+
+    // ---------------- 多项式求值 ----------------
+    k.push_back({"poly/horner_deg7", {1L << 22}, [](long n) {
+        auto x = std::make_shared<std::vector<double>>(random_vector(n, -1.0, 1.0, BENCH_SEED));
+        auto y = std::make_shared<std::vector<double>>(n);
+        return Case{[=] {
+                        static const double c[8] = {1, -0.5, 0.25, -0.125, 0.0625, -0.03125, 0.015625, -0.0078125};
+                        poly_eval_batch<PolyScheme::Horner, 7>(c, x->data(), y->data(), n);
+                    },
+                    14.0 * n, 16.0 * n};
+    }});
+    k.push_back({"poly/estrin_deg15", {1L << 22}, [](long n) {
+        auto x = std::make_shared<std::vector<double>>(random_vector(n, -1.0, 1.0, BENCH_SEED));
+        auto y = std::make_shared<std::vector<double>>(n);
+        auto c = std::make_shared<std::vector<double>>(random_vector(16, -1.0, 1.0, BENCH_SEED + 1));
+        return Case{[=] { poly_eval_batch<PolyScheme::Estrin, 15>(c->data(), x->data(), y->data(), n); }, 30.0 * n,
+                    16.0 * n};
+    }});
+
+    // ---------------- 最小二乘拟合 ----------------
+    k.push_back({"lsq/polyfit_deg12", {1L << 20}, [](long n) {
+        auto x = std::make_shared<std::vector<double>>(random_vector(n, 0.0, 10.0, BENCH_SEED));
+        auto y = std::make_shared<std::vector<double>>(random_vector(n, -1.0, 1.0, BENCH_SEED + 1));
+        // 每个样本约 2 p^2 次乘加（p = 13）
+        return Case{[=] { bench_sink = lsq_polyfit(x->data(), y->data(), n, 12, 0, 10).rss; }, 4.0 * 13 * 14 * n,
+                    16.0 * n};
+    }});
+    k.push_back({"lsq/batch_shared_deg3", {10000}, [](long n) {
+        // 规模为序列条数，每条 200 点
+        auto grid = std::make_shared<std::vector<double>>(200);
+        for (int i = 0; i < 200; i++) (*grid)[i] = i / 199.0;
+        auto y = std::make_shared<std::vector<double>>(random_vector(200 * n, -1.0, 1.0, BENCH_SEED));
+        return Case{[=] { bench_sink = lsq_polyfit_shared(grid->data(), y->data(), 200, (int) n, 3, 0, 1)[0].rss; },
+                    4.0 * 4 * 200 * n, 8.0 * 200 * n};
+    }});
+
+    // ---------------- 切比雪夫逼近 ----------------
+    k.push_back({"chebyshev/interpolate", {1L << 16}, [](long n) {
+        // 规模为插值次数 n（n + 1 个采样点与一次长 2n 的 FFT）；FFT 要求 2 的幂，--scale 后向上取整
+        long m = 1;
+        while (m < n) m *= 2;
+        return Case{[m] {
+                        auto f = [](double x) { return exp(sin(5 * x)); };
+                        ChebyshevSeries s = chebyshev_interpolate(f, -1, 1, (int) m);
+                        bench_sink = s.status == 0 ? s.coef[1] : 0.0;
+                    },
+                    0.0, 16.0 * m};
+    }});
+    k.push_back({"chebyshev/clenshaw_batch_deg64", {1L << 20}, [](long n) {
+        auto f = [](double x) { return exp(sin(5 * x)); };
+        auto s = std::make_shared<ChebyshevSeries>(chebyshev_interpolate(f, -1, 1, 64));
+        auto x = std::make_shared<std::vector<double>>(random_vector(n, -1.0, 1.0, BENCH_SEED));
+        auto y = std::make_shared<std::vector<double>>(n);
+        return Case{[=] { s->eval(x->data(), y->data(), (int) n); }, 4.0 * 64 * n, 16.0 * n};
+    }});
+
+    // ---------------- 求根 ----------------
+    k.push_back({"roots/brent_batch", {100000}, [](long n) {
+        auto c = std::make_shared<std::vector<double>>(random_vector(n, -100.0, 100.0, BENCH_SEED));
+        auto lo = std::make_shared<std::vector<double>>(n, -10.0);
+        auto hi = std::make_shared<std::vector<double>>(n, 10.0);
+        auto out = std::make_shared<std::vector<RootResult>>(n);
+        return Case{[=] {
+                        find_roots_batch([&](int i) { return CubicValue{(*c)[i]}; }, (int) n, lo->data(), hi->data(),
+                                         nullptr, out->data());
+                    },
+                    0.0, 0.0};
+    }});
+    k.push_back({"roots/newton_batch", {100000}, [](long n) {
+        auto c = std::make_shared<std::vector<double>>(random_vector(n, -100.0, 100.0, BENCH_SEED));
+        auto lo = std::make_shared<std::vector<double>>(n, -10.0);
+        auto hi = std::make_shared<std::vector<double>>(n, 10.0);
+        auto out = std::make_shared<std::vector<RootResult>>(n);
+        return Case{[=] {
+                        find_roots_batch([&](int i) { return CubicDerivative{(*c)[i]}; }, (int) n, lo->data(),
+                                         hi->data(), nullptr, out->data());
+                    },
+                    0.0, 0.0};
+    }});
+    k.push_back({"roots/quadratic_batch", {1L << 20}, [](long n) {
+        auto a = std::make_shared<std::vector<double>>(random_vector(n, -10.0, 10.0, BENCH_SEED));
+        auto b = std::make_shared<std::vector<double>>(random_vector(n, -10.0, 10.0, BENCH_SEED + 1));
+        auto c = std::make_shared<std::vector<double>>(random_vector(n, -10.0, 10.0, BENCH_SEED + 2));
+        auto x1 = std::make_shared<std::vector<double>>(n);
+        auto x2 = std::make_shared<std::vector<double>>(n);
+        auto st = std::make_shared<std::vector<int>>(n);
+        return Case{[=] {
+                        quadratic_solve_batch(a->data(), b->data(), c->data(), (int) n, x1->data(), x2->data(),
+                                              st->data());
+                    },
+                    12.0 * n, 44.0 * n};
+    }});
+    k.push_back({"roots/ellipse_distance", {1L << 20}, [](long n) {
+        auto px = std::make_shared<std::vector<double>>(random_vector(n, -5.0, 5.0, BENCH_SEED));
+        auto py = std::make_shared<std::vector<double>>(random_vector(n, -5.0, 5.0, BENCH_SEED + 1));
+        auto a = std::make_shared<std::vector<double>>(random_vector(n, 2.0, 4.0, BENCH_SEED + 2));
+        auto b = std::make_shared<std::vector<double>>(random_vector(n, 0.5, 2.0, BENCH_SEED + 3));
+        auto dist = std::make_shared<std::vector<double>>(n);
+        return Case{[=] {
+                        ellipse_distance_batch(px->data(), py->data(), a->data(), b->data(), (int) n, nullptr, nullptr,
+                                               dist->data());
+                    },
+                    0.0, 40.0 * n};
+    }});
+
+    // ---------------- 曲线求值 ----------------
+    auto bezier_eval_kernel = [](int degree) {
+        return [degree](long m) {
+            auto ctrl = std::make_shared<std::vector<double>>(random_vector(2L * (degree + 1), 0.0, 10.0, BENCH_SEED));
+            auto t = std::make_shared<std::vector<double>>(m);
+            for (long i = 0; i < m; i++) (*t)[i] = (double) i / (m > 1 ? m - 1 : 1);
+            auto out = std::make_shared<std::vector<double>>(2 * m);
+            return Case{[=] { bezier_eval(ctrl->data(), degree, 2, t->data(), (int) m, out->data()); },
+                        4.0 * degree * 2 * m, 24.0 * m};
+        };
+    };
+    k.push_back({"curve/bezier_eval_deg3", {1L << 20}, bezier_eval_kernel(3)});
+    k.push_back({"curve/bezier_eval_deg99", {1L << 16}, bezier_eval_kernel(99)});
+    k.push_back({"curve/bezier_flatten_deg99", {1000000}, [](long n) {
+        // 规模为 1 / 容限
+        auto ctrl = std::make_shared<std::vector<double>>(random_vector(200, 0.0, 10.0, BENCH_SEED));
+        auto out = std::shared_ptr<PointSet>(new PointSet, [](PointSet *p) {
+            point_set_free(p);
+            delete p;
+        });
+        point_set_init(out.get());
+        return Case{[=] {
+                        point_set_clear(out.get());
+                        bezier_flatten(ctrl->data(), 99, 1.0 / n, out.get());
+                    },
+                    0.0, 0.0};
+    }});
+    return k;
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr,
+            "用法: %s [--filter 子串] [--scale 倍数] [--warmup 次数] [--reps 次数]\n"
+            "          [--json 输出文件] [--baseline 基线文件] [--tolerance 比例] [--list]\n",
+            prog);
+}
+
+int main(int argc, char *argv[]) {
+    const char *filter = nullptr, *json_path = nullptr, *baseline_path = nullptr;
+    double scale = 1.0, tolerance = 0.10;
+    int warmup = 2, reps = 9, list = 0;
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        const char *value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (strcmp(arg, "--list") == 0) {
+            list = 1;
+            continue;
+        }
+        if (value == nullptr) {
+            usage(argv[0]);
+            return 2;
+        }
+        if (strcmp(arg, "--filter") == 0) filter = value;
+        else if (strcmp(arg, "--scale") == 0) scale = atof(value);
+        else if (strcmp(arg, "--warmup") == 0) warmup = atoi(value);
+        else if (strcmp(arg, "--reps") == 0) reps = atoi(value);
+        else if (strcmp(arg, "--json") == 0) json_path = value;
+        else if (strcmp(arg, "--baseline") == 0) baseline_path = value;
+        else if (strcmp(arg, "--tolerance") == 0) tolerance = atof(value);
+        else {
+            usage(argv[0]);
+            return 2;
+        }
+        i++;
+    }
+    if (scale <= 0.0 || warmup < 0 || reps < 1 || reps > BENCH_MAX_REPS) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    int threads = 1;
+#ifdef _OPENMP
+    threads = omp_get_max_threads();
+#endif
+    std::vector<Kernel> kernels = make_kernels();
+    std::vector<BenchResult> results;
+    printf("%-32s %10s %12s %12s %14s %10s %10s\n", "测试", "规模", "中位数(ms)", "最短(ms)", "周期", "GFLOP/s", "GB/s");
+    for (const Kernel &kernel : kernels) {
+        if (filter != nullptr && strstr(kernel.name, filter) == nullptr) continue;
+        for (long base : kernel.sizes) {
+            long size = (long) (base * scale) > 0 ? (long) (base * scale) : 1;
+            if (list) {
+                printf("%-32s %10ld\n", kernel.name, size);
+                continue;
+            }
+            Case c = kernel.make(size);
+            if (!c.run) {
+                printf("%-32s %10ld 准备失败（内存不足或数据非法），跳过\n", kernel.name, size);
+                continue;
+            }
+            BenchResult r;
+            bench_run(kernel.name, size, [](void *ctx) { (*static_cast<std::function<void()> *>(ctx))(); }, &c.run,
+                      warmup, reps, c.flops, c.bytes, &r);
+            printf("%-32s %10ld %12.4f %12.4f %14.4g %10.3f %10.3f\n", r.name, r.size, r.median * 1e3, r.best * 1e3,
+                   r.cycles, r.flops / r.median * 1e-9, r.bytes / r.median * 1e-9);
+            fflush(stdout);
+            if (results.size() < BENCH_MAX_RESULTS) results.push_back(r);
+        }
+    }
+    if (list) return 0;
+
+    if (json_path != nullptr) {
+        FILE *file = strcmp(json_path, "-") == 0 ? stdout : fopen(json_path, "w");
+        if (file == nullptr) {
+            perror(json_path);
+            return 2;
+        }
+        bench_json_write(file, results.data(), (int) results.size(), threads);
+        if (file != stdout) fclose(file);
+    }
+
+    if (baseline_path != nullptr) {
+        FILE *file = fopen(baseline_path, "r");
+        if (file == nullptr) {
+            perror(baseline_path);
+            return 2;
+        }
+        std::vector<BenchResult> base(BENCH_MAX_RESULTS);
+        int base_count = bench_json_read(file, base.data(), BENCH_MAX_RESULTS);
+        fclose(file);
+        printf("\n与基线 %s 比较（容差 %.0f%%）:\n", baseline_path, tolerance * 100);
+        int regressions = bench_compare_baseline(results.data(), (int) results.size(), base.data(), base_count,
+                                                 tolerance, stdout);
+        printf("回归 %d 项\n", regressions);
+        if (regressions > 0) return 1;
+    }
+    return 0;
+}
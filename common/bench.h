@@ -0,0 +1,188 @@
+/**
+ * @Descripttion: 基准测试设施：单调墙钟计时、周期计数、预热 + 重复测量取中位数、JSON 输出与基线比较
+ * @filename: bench.h
+ * @Author: 王春博
+ * @Date: 2026.10.19
+ * @Version: V1.0
+ *
+ * clock() 量的是进程 CPU 时间，多线程时是各线程之和，单线程时也包含不到计时器分辨率的误差；
+ * 这里统一用单调墙钟（Windows 为 QueryPerformanceCounter，其他平台为 CLOCK_MONOTONIC）。
+ * x86 上另记时间戳计数器（TSC）的周期数，它按标称频率计数，与睿频无关，可用来粗略比较不同机器。
+ * JSON 每条结果占一行，读基线时逐行解析即可，不依赖 JSON 库。C 与 C++ 均可直接包含。
+ */
+
+#ifndef COMMON_BENCH_H
+#define COMMON_BENCH_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#define BENCH_HAVE_TSC 1
+#else
+#define BENCH_HAVE_TSC 0
+#endif
+
+#define BENCH_NAME_MAX 64   // 测试名的最大长度（含结尾的 0）
+#define BENCH_MAX_REPS 1000 // 重复次数上限
+
+typedef struct {
+    char name[BENCH_NAME_MAX];
+    long size;        // 问题规模（各测试自行定义，如矩阵阶数、点数）
+    int reps;
+    double best;      // 最短耗时（秒）
+    double median;    // 耗时中位数（秒），比较与回归判断都用它
+    double mean;
+    double cycles;    // 中位数对应的 TSC 周期数，不支持时为 0
+    double flops;     // 每次调用的浮点运算量估计
+    double bytes;     // 每次调用的访存量估计
+} BenchResult;
+
+typedef void (*BenchFn)(void *ctx);
+
+// 单调墙钟，单位秒
+static inline double bench_now(void) {
+#ifdef _WIN32
+    LARGE_INTEGER freq, count;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&count);
+    return (double) count.QuadPart / (double) freq.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec + (double) ts.tv_nsec * 1e-9;
+#endif
+}
+
+static inline uint64_t bench_cycles(void) {
+#if BENCH_HAVE_TSC
+    return (uint64_t) __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+static inline int bench_compare_double(const void *p, const void *q) {
+    double a = *(const double *) p, b = *(const double *) q;
+    return a < b ? -1 : (a > b ? 1 : 0);
+}
+
+// 先调用 warmup 次不计时，再计时 reps 次；成功返回 0，参数非法返回 -1
+static inline int bench_run(const char *name, long size, BenchFn fn, void *ctx, int warmup, int reps,
+                            double flops, double bytes, BenchResult *out) {
+    if (reps < 1 || reps > BENCH_MAX_REPS) return -1;
+    double seconds[BENCH_MAX_REPS], cycles[BENCH_MAX_REPS];
+    for (int r = 0; r < warmup; r++) fn(ctx);
+    for (int r = 0; r < reps; r++) {
+        uint64_t c0 = bench_cycles();
+        double t0 = bench_now();
+        fn(ctx);
+        double t1 = bench_now();
+        uint64_t c1 = bench_cycles();
+        seconds[r] = t1 - t0;
+        cycles[r] = (double) (c1 - c0);
+    }
+    double sum = 0.0;
+    for (int r = 0; r < reps; r++) sum += seconds[r];
+    qsort(seconds, (size_t) reps, sizeof(double), bench_compare_double);
+    qsort(cycles, (size_t) reps, sizeof(double), bench_compare_double);
+    snprintf(out->name, BENCH_NAME_MAX, "%s", name);
+    out->size = size;
+    out->reps = reps;
+    out->best = seconds[0];
+    out->median = reps % 2 ? seconds[reps / 2] : 0.5 * (seconds[reps / 2 - 1] + seconds[reps / 2]);
+    out->mean = sum / reps;
+    out->cycles = reps % 2 ? cycles[reps / 2] : 0.5 * (cycles[reps / 2 - 1] + cycles[reps / 2]);
+    out->flops = flops;
+    out->bytes = bytes;
+    return 0;
+}
+
+// 写出 JSON：{"results": [...]}，每条结果一行；threads 为测量时的线程数
+static inline void bench_json_write(FILE *file, const BenchResult *r, int count, int threads) {
+    fprintf(file, "{\n  \"threads\": %d,\n  \"results\": [\n", threads);
+    for (int k = 0; k < count; k++) {
+        double gflops = r[k].median > 0.0 ? r[k].flops / r[k].median * 1e-9 : 0.0;
+        double gbytes = r[k].median > 0.0 ? r[k].bytes / r[k].median * 1e-9 : 0.0;
+        fprintf(file,
+                "    {\"name\": \"%s\", \"size\": %ld, \"reps\": %d, \"best_s\": %.9g, \"median_s\": %.9g, "
+                "\"mean_s\": %.9g, \"cycles\": %.6g, \"flops\": %.6g, \"bytes\": %.6g, \"gflops\": %.4g, "
+                "\"gbytes_per_s\": %.4g}%s\n",
+                r[k].name, r[k].size, r[k].reps, r[k].best, r[k].median, r[k].mean, r[k].cycles, r[k].flops,
+                r[k].bytes, gflops, gbytes, k + 1 < count ? "," : "");
+    }
+    fprintf(file, "  ]\n}\n");
+}
+
+// 在一行中查找 "key": 后的数值，找不到返回 0
+static inline int bench_json_number(const char *line, const char *key, double *value) {
+    char pattern[BENCH_NAME_MAX + 4];
+    snprintf(pattern, sizeof(pattern), "\"%s\":", key);
+    const char *p = strstr(line, pattern);
+    if (p == NULL) return 0;
+    char *end;
+    *value = strtod(p + strlen(pattern), &end);
+    return end != p + strlen(pattern);
+}
+
+// 读回 bench_json_write 写出的文件（只取 name、size、reps、best_s、median_s、mean_s、cycles），返回读到的条数
+static inline int bench_json_read(FILE *file, BenchResult *r, int max) {
+    char line[1024];
+    int count = 0;
+    while (count < max && fgets(line, sizeof(line), file) != NULL) {
+        const char *p = strstr(line, "\"name\": \"");
+        if (p == NULL) continue;
+        p += strlen("\"name\": \"");
+        const char *q = strchr(p, '"');
+        if (q == NULL || q - p >= BENCH_NAME_MAX) continue;
+        BenchResult *b = &r[count];
+        memset(b, 0, sizeof(*b));
+        memcpy(b->name, p, (size_t) (q - p));
+        double size = 0.0, reps = 0.0;
+        if (!bench_json_number(line, "size", &size) || !bench_json_number(line, "median_s", &b->median)) continue;
+        bench_json_number(line, "reps", &reps);
+        bench_json_number(line, "best_s", &b->best);
+        bench_json_number(line, "mean_s", &b->mean);
+        bench_json_number(line, "cycles", &b->cycles);
+        b->size = (long) size;
+        b->reps = (int) reps;
+        count++;
+    }
+    return count;
+}
+
+// 与基线逐条比较（按 name + size 匹配），中位数慢于基线 (1 + tolerance) 倍的记为回归；
+// 报告写到 report，返回回归条数
+static inline int bench_compare_baseline(const BenchResult *cur, int count, const BenchResult *base, int base_count,
+                                         double tolerance, FILE *report) {
+    int regressions = 0;
+    for (int k = 0; k < count; k++) {
+        const BenchResult *b = NULL;
+        for (int m = 0; m < base_count && b == NULL; m++) {
+            if (base[m].size == cur[k].size && strcmp(base[m].name, cur[k].name) == 0) b = &base[m];
+        }
+        if (b == NULL || b->median <= 0.0) {
+            fprintf(report, "  %-32s %10ld  基线中无此项\n", cur[k].name, cur[k].size);
+            continue;
+        }
+        double ratio = cur[k].median / b->median;
+        int slow = ratio > 1.0 + tolerance;
+        regressions += slow;
+        fprintf(report, "  %-32s %10ld  %10.4g ms -> %10.4g ms  x%.3f%s\n", cur[k].name, cur[k].size, b->median * 1e3,
+                cur[k].median * 1e3, ratio, slow ? "  回归" : (ratio < 1.0 - tolerance ? "  提升" : ""));
+    }
+    return regressions;
+}
+
+#endif // COMMON_BENCH_H
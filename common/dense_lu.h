@@ -0,0 +1,32 @@
+/**
+ * @Descripttion: 稠密 LU 分解（部分选主元）、LU 回代、1-范数与 Hager/Higham 条件数估计，double 与 float 共用一份实现
+ * @filename: dense_lu.h
+ * @Author: 王春博
+ * @Date: 2026.10.19
+ * @Version: V1.1
+ *
+ * 矩阵按行优先连续存放，A[i * lda + j]，C 程序可直接传 Matrix.data 与 Matrix.ld；分解就地进行，L 的单位对角线不存储。
+ * 换行只改排列向量：逻辑第 i 行存放在物理第 perm[i] 行，数据本身不移动。
+ * 函数体在 dense_lu_impl.h 中按元素类型展开两次：double 版为 dense_lu_factor 等，float 版加后缀 _f。
+ * 本文件不分配内存，回代与条件数估计的工作区由调用方提供；C++ 程序请用 第四周/lu.hpp 的模板包装。
+ */
+
+#ifndef COMMON_DENSE_LU_H
+#define COMMON_DENSE_LU_H
+
+#include <stddef.h>
+#include <math.h>
+
+#define DENSE_LU_PARALLEL_MIN 128  // 剩余子矩阵行数不少于此值时才并行更新
+#define DENSE_CONDEST_ITER 5       // Hager 迭代的最大次数
+#define DENSE_CONDEST_WORK(n) (4 * (size_t) (n))  // dense_lu_condest 的工作区元素个数
+
+#define DENSE_T double
+#define DENSE_FN(name) name
+#include "dense_lu_impl.h"
+
+#define DENSE_T float
+#define DENSE_FN(name) name##_f
+#include "dense_lu_impl.h"
+
+#endif // COMMON_DENSE_LU_H
@@ -0,0 +1,154 @@
+/**
+ * @Descripttion: 稠密 LU 分解的函数体，按元素类型展开；只由 dense_lu.h 包含
+ * @filename: dense_lu_impl.h
+ * @Author: 王春博
+ * @Date: 2026.10.19
+ * @Version: V1.0
+ *
+ * 包含前定义 DENSE_T（元素类型）与 DENSE_FN(name)（函数名），包含后两者被取消定义，可再次包含展开另一种类型。
+ * 故意不加包含保护。
+ */
+
+// 就地 LU 分解：perm 为输出的行排列；growth 非空时写入主元增长因子 max|U| / max|A|
+// 成功返回 0，遇到零主元或非有限主元返回其列号 + 1
+static inline int DENSE_FN(dense_lu_factor)(DENSE_T *a, int n, int lda, int *perm, double *growth) {
+    double max_a = 0.0, max_u = 0.0;
+    for (int i = 0; i < n; i++) {
+        perm[i] = i;
+        if (growth != NULL) {
+            const DENSE_T *ri = a + (long) i * lda;
+            for (int j = 0; j < n; j++) max_a = fmax(max_a, fabs(ri[j]));
+        }
+    }
+
+    for (int k = 0; k < n; k++) {
+        // 选列主元，只交换排列向量
+        int p = k;
+        DENSE_T max_abs = fabs(a[(long) perm[k] * lda + k]);
+        for (int i = k + 1; i < n; i++) {
+            DENSE_T v = fabs(a[(long) perm[i] * lda + k]);
+            if (v > max_abs) {
+                max_abs = v;
+                p = i;
+            }
+        }
+        int temp = perm[k];
+        perm[k] = perm[p];
+        perm[p] = temp;
+        if (max_abs == 0 || !isfinite(max_abs)) return k + 1;
+
+        // 第 k 行已是 U 的最终一行，顺便统计增长因子，总代价 O(n^2)
+        const DENSE_T *rk = a + (long) perm[k] * lda;
+        if (growth != NULL) {
+            for (int j = k; j < n; j++) max_u = fmax(max_u, fabs(rk[j]));
+        }
+
+        // 消元：更新剩余子矩阵
+        DENSE_T inv = (DENSE_T) 1 / rk[k];
+        #pragma omp parallel for schedule(static) if (n - k > DENSE_LU_PARALLEL_MIN)
+        for (int i = k + 1; i < n; i++) {
+            DENSE_T *ri = a + (long) perm[i] * lda;
+            DENSE_T l = ri[k] * inv;
+            ri[k] = l;
+            if (l == 0) continue;  // 稀疏矩阵中该行无需消元
+            #pragma omp simd
+            for (int j = k + 1; j < n; j++) {
+                ri[j] -= l * rk[j];
+            }
+        }
+    }
+    if (growth != NULL) *growth = max_a > 0.0 ? max_u / max_a : 0.0;
+    return 0;
+}
+
+// 用分解结果求解 A x = b，b 就地替换为 x；work 为 n 个元素的工作区
+static inline void DENSE_FN(dense_lu_solve)(const DENSE_T *lu, int n, int lda, const int *perm, DENSE_T *b,
+                                            DENSE_T *work) {
+    for (int i = 0; i < n; i++) work[i] = b[i];
+    // 前代：单位下三角，右端项按排列取
+    for (int i = 0; i < n; i++) {
+        const DENSE_T *ri = lu + (long) perm[i] * lda;
+        DENSE_T s = work[perm[i]];
+        for (int j = 0; j < i; j++) s -= ri[j] * b[j];
+        b[i] = s;
+    }
+    // 回代：上三角
+    for (int i = n - 1; i >= 0; i--) {
+        const DENSE_T *ri = lu + (long) perm[i] * lda;
+        DENSE_T s = b[i];
+        for (int j = i + 1; j < n; j++) s -= ri[j] * b[j];
+        b[i] = s / ri[i];
+    }
+}
+
+// 求解 A^T x = b：U^T w = b，L^T v = w，再按排列放回 x[perm[i]] = v[i]；work 为 n 个元素的工作区
+static inline void DENSE_FN(dense_lu_solve_transposed)(const DENSE_T *lu, int n, int lda, const int *perm,
+                                                       DENSE_T *b, DENSE_T *work) {
+    DENSE_T *v = work;
+    for (int i = 0; i < n; i++) v[i] = b[i];
+    // U^T 为下三角：按列累加，保持按行访问存储
+    for (int i = 0; i < n; i++) {
+        const DENSE_T *ri = lu + (long) perm[i] * lda;
+        v[i] /= ri[i];
+        for (int j = i + 1; j < n; j++) v[j] -= ri[j] * v[i];
+    }
+    // L^T 为单位上三角
+    for (int i = n - 1; i > 0; i--) {
+        const DENSE_T *ri = lu + (long) perm[i] * lda;
+        for (int j = 0; j < i; j++) v[j] -= ri[j] * v[i];
+    }
+    for (int i = 0; i < n; i++) b[perm[i]] = v[i];
+}
+
+// 1-范数（列和的最大值），须在分解前计算；按列遍历，不需要工作区
+static inline double DENSE_FN(dense_lu_norm1)(const DENSE_T *a, int n, int lda) {
+    double norm = 0.0;
+    for (int j = 0; j < n; j++) {
+        double col = 0.0;
+        for (int i = 0; i < n; i++) col += fabs(a[(long) i * lda + j]);
+        norm = fmax(norm, col);
+    }
+    return norm;
+}
+
+// Hager/Higham 条件数估计：返回 kappa_1(A) 的下界估计，anorm 为分解前的 ||A||_1
+// 每次迭代只做一次正向和一次转置三角求解，总代价 O(n^2)；work 为 DENSE_CONDEST_WORK(n) 个元素的工作区
+static inline double DENSE_FN(dense_lu_condest)(const DENSE_T *lu, int n, int lda, const int *perm, double anorm,
+                                                DENSE_T *work) {
+    if (n == 0) return 0.0;
+    DENSE_T *x = work, *xp = work + n, *z = work + 2 * (long) n, *tmp = work + 3 * (long) n;
+    double est = 0.0;
+    for (int i = 0; i < n; i++) x[i] = (DENSE_T) 1 / (DENSE_T) n;
+    for (int iter = 0; iter < DENSE_CONDEST_ITER; iter++) {
+        for (int i = 0; i < n; i++) xp[i] = x[i];
+        DENSE_FN(dense_lu_solve)(lu, n, lda, perm, x, tmp);  // x <- A^{-1} x
+        double norm = 0.0;
+        for (int i = 0; i < n; i++) norm += fabs(x[i]);
+        if (iter > 0 && norm <= est) break;
+        est = norm;
+        for (int i = 0; i < n; i++) z[i] = x[i] >= 0 ? 1 : -1;
+        DENSE_FN(dense_lu_solve_transposed)(lu, n, lda, perm, z, tmp);  // z <- A^{-T} sign(x)
+        int j = 0;
+        double ztx = 0.0;
+        for (int i = 0; i < n; i++) {
+            if (fabs(z[i]) > fabs(z[j])) j = i;
+            ztx += z[i] * xp[i];
+        }
+        if (iter > 0 && fabs(z[j]) <= ztx) break;  // 次梯度不再给出上升方向
+        for (int i = 0; i < n; i++) x[i] = 0;
+        x[j] = 1;
+    }
+    // Higham 的交错符号向量，弥补 Hager 迭代在特殊结构上的低估
+    for (int i = 0; i < n; i++) {
+        DENSE_T v = 1 + (n > 1 ? (DENSE_T) i / (DENSE_T) (n - 1) : 0);
+        x[i] = i % 2 == 0 ? v : -v;
+    }
+    DENSE_FN(dense_lu_solve)(lu, n, lda, perm, x, tmp);
+    double alt = 0.0;
+    for (int i = 0; i < n; i++) alt += fabs(x[i]);
+    alt = 2.0 * alt / (3.0 * n);
+    return anorm * fmax(est, alt);
+}
+
+#undef DENSE_T
+#undef DENSE_FN
@@ -0,0 +1,166 @@
+/**
+ * @Descripttion: 稠密矩阵与向量的存储：64 字节对齐的连续缓冲区、补齐的行距、大页、按线程划分的首次触碰，以及临时向量的内存池
+ * @filename: matrix.h
+ * @Author: 王春博
+ * @Date: 2026.10.19
+ * @Version: V1.0
+ *
+ * 整个矩阵一次分配：元素 (i, j) 位于 data[i * ld + j]，行距 ld 补齐到 8 个 double（一条缓存行），
+ * 每行都从缓存行边界开始；行距恰为 4 KB 整数倍时再加一条缓存行，避免各行同列元素落入同一缓存组。
+ * row[i] 指向第 i 行，可直接交给 banded.h、trisolve.h 等按行指针的接口，消元时换行仍只交换指针。
+ * 不小于 MATRIX_HUGE_BYTES 的缓冲区按 2 MB 对齐并建议内核使用透明大页（Linux），减少 TLB 缺失。
+ * 分配时按行以 schedule(static) 并行清零。之后同样按行 schedule(static) 并行的循环，每页多由使用它的线程首次触碰，
+ * 在多路 NUMA 机器上落在该线程所在节点的内存里；雅可比迭代、高斯消去等串行计算不受益，只是清零本身并行。
+ * C 与 C++ 均可直接包含。
+ */
+
+#ifndef COMMON_MATRIX_H
+#define COMMON_MATRIX_H
+
+#include <stdlib.h>
+#include <string.h>
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+#define MATRIX_ALIGN 64                      // 缓存行
+#define MATRIX_HUGE_BYTES ((size_t) 2 << 20)  // 不小于此大小时按大页对齐
+#define MATRIX_PARALLEL_BYTES ((size_t) 1 << 20)  // 不小于此大小时并行首次触碰
+
+typedef struct {
+    int rows, cols;
+    int ld;         // 行距（元素个数）
+    double *data;
+    double **row;   // row[i] = data + i * ld
+} Matrix;
+
+// 对齐分配 bytes 字节（未初始化），失败返回 NULL；大缓冲区按大页对齐并启用透明大页
+static inline void *aligned_buffer(size_t bytes) {
+    size_t align = bytes >= MATRIX_HUGE_BYTES ? MATRIX_HUGE_BYTES : MATRIX_ALIGN;
+    bytes = (bytes + align - 1) / align * align;
+    void *p = NULL;
+#ifdef _WIN32
+    p = _aligned_malloc(bytes > 0 ? bytes : align, align);
+#else
+    if (posix_memalign(&p, align, bytes > 0 ? bytes : align) != 0) return NULL;
+#endif
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    if (align == MATRIX_HUGE_BYTES) madvise(p, bytes, MADV_HUGEPAGE);
+#endif
+    return p;
+}
+
+static inline void aligned_buffer_free(void *p) {
+#ifdef _WIN32
+    _aligned_free(p);
+#else
+    free(p);
+#endif
+}
+
+// 并行清零：按行 schedule(static) 划分，只对同样划分的并行计算循环起到就近首次触碰的作用
+static inline void matrix_first_touch(double *p, long rows, long ld) {
+    #pragma omp parallel for schedule(static) if ((size_t) rows * ld * sizeof(double) >= MATRIX_PARALLEL_BYTES)
+    for (long i = 0; i < rows; i++) memset(p + i * ld, 0, (size_t) ld * sizeof(double));
+}
+
+// 分配 n 个元素的对齐向量并清零，失败返回 NULL；用 vector_free 释放
+static inline double *vector_alloc(size_t n) {
+    size_t padded = (n + 7) / 8 * 8;
+    double *v = (double *) aligned_buffer(padded * sizeof(double));
+    if (v != NULL) matrix_first_touch(v, (long) (padded / 8), 8);
+    return v;
+}
+
+static inline void vector_free(double *v) {
+    aligned_buffer_free(v);
+}
+
+// 行距：补齐到缓存行；恰为 4 KB 整数倍时再加一条缓存行
+static inline int matrix_leading_dim(int cols) {
+    int ld = (cols + 7) / 8 * 8;
+    if (ld > 0 && ld % 512 == 0) ld += 8;
+    return ld;
+}
+
+// 分配 rows x cols 的清零矩阵，成功返回 0，内存不足返回 -1
+static inline int matrix_alloc(Matrix *m, int rows, int cols) {
+    m->rows = rows;
+    m->cols = cols;
+    m->ld = matrix_leading_dim(cols);
+    m->data = (double *) aligned_buffer((size_t) rows * m->ld * sizeof(double));
+    m->row = (double **) malloc((size_t) (rows > 0 ? rows : 1) * sizeof(double *));
+    if (m->data == NULL || m->row == NULL) {
+        aligned_buffer_free(m->data);
+        free(m->row);
+        m->data = NULL;
+        m->row = NULL;
+        return -1;
+    }
+    for (int i = 0; i < rows; i++) m->row[i] = m->data + (size_t) i * m->ld;
+    matrix_first_touch(m->data, rows, m->ld);
+    return 0;
+}
+
+static inline void matrix_free(Matrix *m) {
+    aligned_buffer_free(m->data);
+    free(m->row);
+    m->data = NULL;
+    m->row = NULL;
+}
+
+// 复制内容（两矩阵同形状），行指针不受影响
+static inline void matrix_copy(Matrix *dst, const Matrix *src) {
+    if (dst->ld == src->ld) {
+        memcpy(dst->data, src->data, (size_t) src->rows * src->ld * sizeof(double));
+        return;
+    }
+    for (int i = 0; i < src->rows; i++) memcpy(dst->row[i], src->row[i], (size_t) src->cols * sizeof(double));
+}
+
+// 临时向量的内存池：一次分配，按缓存行对齐切分，迭代与估计过程中不再调用 malloc
+typedef struct {
+    char *base;
+    size_t size;
+    size_t used;
+} Arena;
+
+// 容量 bytes 字节，成功返回 0
+static inline int arena_init(Arena *a, size_t bytes) {
+    a->base = (char *) aligned_buffer(bytes);
+    a->size = a->base != NULL ? bytes : 0;
+    a->used = 0;
+    return a->base != NULL ? 0 : -1;
+}
+
+// 取 n 个元素的清零向量，容量不足返回 NULL
+static inline double *arena_vector(Arena *a, size_t n) {
+    size_t bytes = (n * sizeof(double) + MATRIX_ALIGN - 1) / MATRIX_ALIGN * MATRIX_ALIGN;
+    if (a->size - a->used < bytes) return NULL;
+    double *v = (double *) (a->base + a->used);
+    a->used += bytes;
+    memset(v, 0, bytes);
+    return v;
+}
+
+// 容纳 count 个 n 元向量所需的容量
+static inline size_t arena_bytes(size_t count, size_t n) {
+    return count * ((n * sizeof(double) + MATRIX_ALIGN - 1) / MATRIX_ALIGN * MATRIX_ALIGN);
+}
+
+// 记下当前位置，之后用 arena_release 一次归还其后取出的全部向量
+static inline size_t arena_mark(const Arena *a) {
+    return a->used;
+}
+
+static inline void arena_release(Arena *a, size_t mark) {
+    a->used = mark;
+}
+
+static inline void arena_free(Arena *a) {
+    aligned_buffer_free(a->base);
+    a->base = NULL;
+    a->size = a->used = 0;
+}
+
+#endif // COMMON_MATRIX_H
@@ -0,0 +1,109 @@
+/**
+ * @Descripttion: 多级流水线：有界阻塞队列连接各级，每级有自己的工作线程，并统计各级的处理量与忙碌时间
+ * @filename: pipeline.hpp
+ * @Author: 王春博
+ * @Date: 2026.10.19
+ * @Version: V1.0
+ *
+ * 队列有界：下游跟不上时上游阻塞在 push 上，内存中在途的任务数不超过各队列容量之和。
+ * 一级的全部线程退出后关闭它的输出队列，下游取空即结束，关闭沿流水线逐级传递。
+ * 工作线程里的 OpenMP 并行区默认只用一个线程，避免各级线程各自再开一组线程造成过度订阅。
+ */
+
+#ifndef COMMON_PIPELINE_HPP
+#define COMMON_PIPELINE_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#include "bench.h"
+
+template <class T>
+class BoundedQueue {
+public:
+    explicit BoundedQueue(size_t capacity) : capacity_(capacity > 0 ? capacity : 1) {}
+
+    // 队列满时阻塞；已关闭返回 false
+    bool push(T item) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        not_full_.wait(lock, [this] { return closed_ || items_.size() < capacity_; });
+        if (closed_) return false;
+        items_.push_back(std::move(item));
+        not_empty_.notify_one();
+        return true;
+    }
+
+    // 队列空时阻塞；已关闭且取空返回 false
+    bool pop(T &item) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        not_empty_.wait(lock, [this] { return closed_ || !items_.empty(); });
+        if (items_.empty()) return false;
+        item = std::move(items_.front());
+        items_.pop_front();
+        not_full_.notify_one();
+        return true;
+    }
+
+    void close() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+        not_empty_.notify_all();
+        not_full_.notify_all();
+    }
+
+private:
+    size_t capacity_;
+    bool closed_ = false;
+    std::deque<T> items_;
+    std::mutex mutex_;
+    std::condition_variable not_empty_, not_full_;
+};
+
+// 一级的统计：处理的任务数、字节数（由处理函数自行累加）与各线程忙碌时间之和
+struct StageCounter {
+    const char *name;
+    int threads = 0;
+    std::atomic<long> items{0};
+    std::atomic<long long> bytes{0};
+    std::atomic<long long> busy_ns{0};
+
+    explicit StageCounter(const char *stage_name) : name(stage_name) {}
+    double busy_seconds() const { return busy_ns.load() * 1e-9; }
+};
+
+// 启动一级：threads 个线程从 in 取任务交给 fn(item)，fn 返回 true 时把 item 放入 out；
+// 全部线程结束后关闭 out。返回的线程由调用方 join
+template <class T, class Fn>
+std::vector<std::thread> pipeline_stage(int threads, BoundedQueue<T> &in, BoundedQueue<T> &out, StageCounter &counter,
+                                        Fn fn) {
+    threads = threads > 0 ? threads : 1;
+    counter.threads = threads;
+    auto remaining = std::make_shared<std::atomic<int>>(threads);
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; t++) {
+        pool.emplace_back([&in, &out, &counter, fn, remaining] {
+#ifdef _OPENMP
+            omp_set_num_threads(1);
+#endif
+            T item;
+            while (in.pop(item)) {
+                double t0 = bench_now();
+                bool keep = fn(item);
+                counter.busy_ns += (long long) ((bench_now() - t0) * 1e9);
+                counter.items++;
+                if (keep && !out.push(std::move(item))) break;
+            }
+            if (--*remaining == 0) out.close();
+        });
+    }
+    return pool;
+}
+
+#endif // COMMON_PIPELINE_HPP
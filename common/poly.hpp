@@ -0,0 +1,201 @@
+/**
+ * @Descripttion: 多项式求值：次数为编译期常量时完全展开的 Horner、Estrin、Clenshaw（切比雪夫级数）与 de Casteljau（伯恩斯坦基），
+ *                一趟同时求值与导数，跨数组批量求值
+ * @filename: poly.hpp
+ * @Author: 王春博
+ * @Date: 2026.10.19
+ * @Version: V1.0
+ *
+ * 系数一律按升幂存放：c[k] 是 x^k（或 T_k、第 k 个伯恩斯坦基）的系数，N 为次数，共 N + 1 个系数。
+ * Horner 每步依赖上一步，延迟为 N 次乘加；Estrin 把多项式按 x^(2^j) 二分，依赖链缩短到 log2 N 层，
+ * 单点求值时指令级并行更好。批量求值时各点互不相关，跨点向量化后 Horner 已能填满流水线，两者差别不大。
+ * 模板参数 T 可以是 double 或 float，x 与返回值同类型，系数总按 double 传入。
+ */
+
+#ifndef COMMON_POLY_HPP
+#define COMMON_POLY_HPP
+
+enum class PolyScheme {
+    Horner,
+    Estrin,
+    Clenshaw,  // 系数为切比雪夫级数系数，x 应在 [-1, 1]
+    Bernstein  // 系数为伯恩斯坦基系数（贝塞尔控制点的一维分量），x 应在 [0, 1]
+};
+
+namespace poly_detail {
+
+template <int K, class T>
+inline T horner_step(const double *c, T x, T acc) {
+    if constexpr (K == 0) {
+        return acc;
+    } else {
+        return horner_step<K - 1>(c, x, acc * x + T(c[K - 1]));
+    }
+}
+
+template <int K, class T>
+inline T horner_deriv_step(const double *c, T x, T p, T d, T &df) {
+    if constexpr (K == 0) {
+        df = d;
+        return p;
+    } else {
+        return horner_deriv_step<K - 1>(c, x, p * x + T(c[K - 1]), d * x + p, df);
+    }
+}
+
+// 不超过 n 的最大 2 的幂（n >= 1）
+constexpr int floor_pow2(int n) {
+    int m = 1;
+    while (2 * m <= n) m *= 2;
+    return m;
+}
+
+constexpr int log2_exact(int m) {
+    int j = 0;
+    while ((1 << j) < m) j++;
+    return j;
+}
+
+// pw[j] = x^(2^j)；p(x) = low(x) + x^M high(x)，M 为不超过 N 的最大 2 的幂
+template <int N, class T>
+inline T estrin(const double *c, const T *pw) {
+    if constexpr (N == 0) {
+        return T(c[0]);
+    } else if constexpr (N == 1) {
+        return T(c[0]) + T(c[1]) * pw[0];
+    } else {
+        constexpr int M = floor_pow2(N);
+        return estrin<M - 1>(c, pw) + pw[log2_exact(M)] * estrin<N - M>(c + M, pw);
+    }
+}
+
+template <int K, class T>
+inline T clenshaw_step(const double *c, T t, T b1, T b2) {
+    if constexpr (K == 0) {
+        return t * b1 - b2 + T(c[0]);
+    } else {
+        return clenshaw_step<K - 1>(c, t, T(2) * t * b1 - b2 + T(c[K]), b1);
+    }
+}
+
+// de Casteljau 的一层：b[i] <- (1 - t) b[i] + t b[i + 1]，i < K
+template <int K, class T>
+inline T casteljau(T *b, T t) {
+    if constexpr (K == 0) {
+        return b[0];
+    } else {
+        for (int i = 0; i < K; i++) b[i] = b[i] + t * (b[i + 1] - b[i]);
+        return casteljau<K - 1>(b, t);
+    }
+}
+
+}  // namespace poly_detail
+
+// Horner：c[0] + c[1] x + ... + c[N] x^N
+template <int N, class T>
+inline T poly_horner(const double *c, T x) {
+    return poly_detail::horner_step<N>(c, x, T(c[N]));
+}
+
+// 一趟 Horner 同时得到 p(x) 与 p'(x)，牛顿迭代用
+template <int N, class T>
+inline T poly_horner_deriv(const double *c, T x, T &df) {
+    if constexpr (N == 0) {
+        df = T(0);
+        return T(c[0]);
+    } else {
+        return poly_detail::horner_deriv_step<N - 1>(c, x, T(c[N]) * x + T(c[N - 1]), T(c[N]), df);
+    }
+}
+
+// Estrin：先算 x, x^2, x^4, ...，再按二叉树合并
+template <int N, class T>
+inline T poly_estrin(const double *c, T x) {
+    constexpr int levels = N >= 1 ? poly_detail::log2_exact(poly_detail::floor_pow2(N)) + 1 : 1;
+    T pw[levels];
+    pw[0] = x;
+    for (int j = 1; j < levels; j++) pw[j] = pw[j - 1] * pw[j - 1];
+    return poly_detail::estrin<N>(c, pw);
+}
+
+// Clenshaw：切比雪夫级数 Σ c[k] T_k(t)
+template <int N, class T>
+inline T poly_clenshaw(const double *c, T t) {
+    if constexpr (N == 0) {
+        return T(c[0]);
+    } else {
+        return poly_detail::clenshaw_step<N - 1>(c, t, T(c[N]), T(0));
+    }
+}
+
+// de Casteljau：伯恩斯坦基 Σ c[k] C(N,k) (1-t)^(N-k) t^k，数值稳定，不需要二项式系数与幂
+template <int N, class T>
+inline T poly_bernstein(const double *c, T t) {
+    T b[N + 1];
+    for (int k = 0; k <= N; k++) b[k] = T(c[k]);
+    return poly_detail::casteljau<N>(b, t);
+}
+
+template <PolyScheme S, int N, class T>
+inline T poly_eval(const double *c, T x) {
+    if constexpr (S == PolyScheme::Horner) {
+        return poly_horner<N>(c, x);
+    } else if constexpr (S == PolyScheme::Estrin) {
+        return poly_estrin<N>(c, x);
+    } else if constexpr (S == PolyScheme::Clenshaw) {
+        return poly_clenshaw<N>(c, x);
+    } else {
+        return poly_bernstein<N>(c, x);
+    }
+}
+
+// 批量求值 y[i] = p(x[i])：次数与方法在编译期确定，循环体完全展开后跨点向量化
+template <PolyScheme S, int N, class T>
+inline void poly_eval_batch(const double *c, const T *x, T *y, long n) {
+    #pragma omp parallel for simd schedule(static) if (n >= 65536)
+    for (long i = 0; i < n; i++) y[i] = poly_eval<S, N>(c, x[i]);
+}
+
+// 批量同时求值与导数
+template <int N, class T>
+inline void poly_horner_deriv_batch(const double *c, const T *x, T *y, T *dy, long n) {
+    #pragma omp parallel for simd schedule(static) if (n >= 65536)
+    for (long i = 0; i < n; i++) {
+        T d;
+        y[i] = poly_horner_deriv<N>(c, x[i], d);
+        dy[i] = d;
+    }
+}
+
+// 次数只在运行时知道时的 Horner（不展开）
+template <class T>
+inline T poly_horner(const double *c, int degree, T x) {
+    T acc = T(c[degree]);
+    for (int k = degree - 1; k >= 0; k--) acc = acc * x + T(c[k]);
+    return acc;
+}
+
+template <class T>
+inline T poly_horner_deriv(const double *c, int degree, T x, T &df) {
+    T p = T(c[degree]), d = T(0);
+    for (int k = degree - 1; k >= 0; k--) {
+        d = d * x + p;
+        p = p * x + T(c[k]);
+    }
+    df = d;
+    return p;
+}
+
+// 次数只在运行时知道时的 Clenshaw（不展开），t 应在 [-1, 1]
+template <class T>
+inline T poly_clenshaw(const double *c, int degree, T t) {
+    T b1 = T(0), b2 = T(0);
+    for (int k = degree; k >= 1; k--) {
+        T b = T(2) * t * b1 - b2 + T(c[k]);
+        b2 = b1;
+        b1 = b;
+    }
+    return t * b1 - b2 + T(c[0]);
+}
+
+#endif // COMMON_POLY_HPP
@@ -0,0 +1,199 @@
+/**
+ * @Descripttion: 公共随机数设施：xoshiro256** 生成器、按线程号划分的子流、批量填充接口
+ * @filename: rng.h
+ * @Author: 王春博
+ * @Date: 2026.10.19
+ * @Version: V1.0
+ *
+ * 所有问题生成器（椭圆、矩阵、点集）统一使用这里的生成器，给定种子即可复现。
+ * 生成器状态一律由调用方持有（Rng 变量），没有全局或隐藏的线程局部状态；多线程时每个线程用自己的 Rng。
+ * C 与 C++ 均可直接包含。
+ */
+
+#ifndef COMMON_RNG_H
+#define COMMON_RNG_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <math.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#define RNG_CHUNK 4096                // 并行填充时每个独立子流负责的元素个数
+
+typedef struct {
+    uint64_t s[4];
+} Rng;
+
+static inline uint64_t rng_rotl(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+// splitmix64：用于把一个种子展开为生成器状态
+static inline uint64_t rng_splitmix64(uint64_t *x) {
+    uint64_t z = (*x += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static inline void rng_init(Rng *r, uint64_t seed) {
+    uint64_t x = seed;
+    for (int i = 0; i < 4; i++) r->s[i] = rng_splitmix64(&x);
+}
+
+// 由 (种子, 子流号) 初始化一个独立子流，并行分块时各块互不相关且与线程数无关
+static inline void rng_init_stream(Rng *r, uint64_t seed, uint64_t stream) {
+    uint64_t x = seed ^ (stream * 0xD1B54A32D192ED03ULL);
+    uint64_t mixed = rng_splitmix64(&x);
+    rng_init(r, mixed ^ stream);
+}
+
+static inline uint64_t rng_next(Rng *r) {
+    uint64_t *s = r->s;
+    uint64_t result = rng_rotl(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rng_rotl(s[3], 45);
+    return result;
+}
+
+// 前进 2^128 步，得到与原序列不重叠的新序列
+static inline void rng_jump(Rng *r) {
+    static const uint64_t jump[4] = {0x180EC6D33CFD0ABAULL, 0xD5A61266F0C9392CULL,
+                                     0xA9582618E03FC9AAULL, 0x39ABDC4529B1661CULL};
+    uint64_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    for (int i = 0; i < 4; i++) {
+        for (int b = 0; b < 64; b++) {
+            if (jump[i] & ((uint64_t) 1 << b)) {
+                s0 ^= r->s[0];
+                s1 ^= r->s[1];
+                s2 ^= r->s[2];
+                s3 ^= r->s[3];
+            }
+            rng_next(r);
+        }
+    }
+    r->s[0] = s0;
+    r->s[1] = s1;
+    r->s[2] = s2;
+    r->s[3] = s3;
+}
+
+// [0, 1) 上的均匀分布，取高 53 位
+static inline double rng_uniform(Rng *r) {
+    return (double) (rng_next(r) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+static inline double rng_uniform_range(Rng *r, double lower_bound, double upper_bound) {
+    return lower_bound + rng_uniform(r) * (upper_bound - lower_bound);
+}
+
+// [0, n) 上的均匀整数（Lemire 乘法取高位 + 拒绝，无偏）
+static inline uint64_t rng_below(Rng *r, uint64_t n) {
+    uint64_t x = rng_next(r);
+#ifdef __SIZEOF_INT128__
+    unsigned __int128 m = (unsigned __int128) x * n;
+    uint64_t low = (uint64_t) m;
+    if (low < n) {
+        uint64_t threshold = (0 - n) % n;
+        while (low < threshold) {
+            x = rng_next(r);
+            m = (unsigned __int128) x * n;
+            low = (uint64_t) m;
+        }
+    }
+    return (uint64_t) (m >> 64);
+#else
+    uint64_t limit = UINT64_MAX - UINT64_MAX % n;
+    while (x >= limit) x = rng_next(r);
+    return x % n;
+#endif
+}
+
+// 标准正态分布（Box-Muller），一次产生两个
+static inline void rng_normal_pair(Rng *r, double *z0, double *z1) {
+    double u1 = 1.0 - rng_uniform(r);  // (0, 1]，避免 log(0)
+    double u2 = rng_uniform(r);
+    double radius = sqrt(-2.0 * log(u1));
+    *z0 = radius * cos(2 * M_PI * u2);
+    *z1 = radius * sin(2 * M_PI * u2);
+}
+
+static inline double rng_normal(Rng *r) {
+    double z0, z1;
+    rng_normal_pair(r, &z0, &z1);
+    return z0;
+}
+
+// 批量填充 [lower_bound, upper_bound) 上的均匀分布
+static inline void rng_fill_uniform(Rng *r, double *out, size_t n, double lower_bound, double upper_bound) {
+    double scale = (upper_bound - lower_bound) * (1.0 / 9007199254740992.0);
+    for (size_t i = 0; i < n; i++) {
+        out[i] = lower_bound + (double) (rng_next(r) >> 11) * scale;
+    }
+}
+
+// 批量填充正态分布 N(mean, stddev^2)
+static inline void rng_fill_normal(Rng *r, double *out, size_t n, double mean, double stddev) {
+    size_t i = 0;
+    for (; i + 1 < n; i += 2) {
+        double z0, z1;
+        rng_normal_pair(r, &z0, &z1);
+        out[i] = mean + stddev * z0;
+        out[i + 1] = mean + stddev * z1;
+    }
+    if (i < n) out[i] = mean + stddev * rng_normal(r);
+}
+
+// 批量生成盒形区域 [lo, hi] 内的 n 个 dim 维点，按点交错存放（out[i * dim + d]）
+static inline void rng_fill_points_box(Rng *r, double *out, size_t n, int dim, const double *lo, const double *hi) {
+    for (size_t i = 0; i < n; i++) {
+        for (int d = 0; d < dim; d++) {
+            out[i * dim + d] = rng_uniform_range(r, lo[d], hi[d]);
+        }
+    }
+}
+
+// 并行批量填充均匀分布：第 c 块固定使用子流 (seed, c)，结果与线程数无关
+static inline void rng_fill_uniform_parallel(uint64_t seed, double *out, size_t n, double lower_bound, double upper_bound) {
+    long chunks = (long) ((n + RNG_CHUNK - 1) / RNG_CHUNK);
+    #pragma omp parallel for schedule(static)
+    for (long c = 0; c < chunks; c++) {
+        Rng r;
+        rng_init_stream(&r, seed, (uint64_t) c);
+        size_t start = (size_t) c * RNG_CHUNK;
+        size_t count = n - start < RNG_CHUNK ? n - start : RNG_CHUNK;
+        rng_fill_uniform(&r, out + start, count, lower_bound, upper_bound);
+    }
+}
+
+// 并行批量填充正态分布，分块规则同上
+static inline void rng_fill_normal_parallel(uint64_t seed, double *out, size_t n, double mean, double stddev) {
+    long chunks = (long) ((n + RNG_CHUNK - 1) / RNG_CHUNK);
+    #pragma omp parallel for schedule(static)
+    for (long c = 0; c < chunks; c++) {
+        Rng r;
+        rng_init_stream(&r, seed, (uint64_t) c);
+        size_t start = (size_t) c * RNG_CHUNK;
+        size_t count = n - start < RNG_CHUNK ? n - start : RNG_CHUNK;
+        rng_fill_normal(&r, out + start, count, mean, stddev);
+    }
+}
+
+// 按当前 OpenMP 线程号初始化子流：并行区内每个线程各自声明一个 Rng 并调用本函数，
+// 状态归调用方所有，不存在跨线程共享的隐藏状态；线程数固定时可复现
+static inline void rng_init_thread(Rng *r, uint64_t seed) {
+    uint64_t stream = 0;
+#ifdef _OPENMP
+    stream = (uint64_t) omp_get_thread_num();
+#endif
+    rng_init_stream(r, seed, stream);
+}
+
+#endif // COMMON_RNG_H
@@ -0,0 +1,256 @@
+/**
+ * @Descripttion: 通用求根引擎：带保护的牛顿法、哈雷法与 Brent 法，括区间兜底，支持批量并行
+ * @filename: roots.hpp
+ * @Author: 王春博
+ * @Date: 2026.10.19
+ * @Version: V1.0
+ *
+ * 函数对象按提供的成员在编译期选择方法：
+ *   double operator()(double x)                              只有函数值 -> Brent
+ *   void eval(double x, double &f, double &df)               一阶导数   -> 牛顿
+ *   void eval(double x, double &f, double &df, double &d2f)  二阶导数   -> 哈雷
+ */
+
+#ifndef COMMON_ROOTS_HPP
+#define COMMON_ROOTS_HPP
+
+#include <cmath>
+#include <type_traits>
+#include <utility>
+#include "trace.h"
+
+// 求根状态
+#define ROOT_CONVERGED 0  // 收敛
+#define ROOT_MAX_ITER 1   // 达到最大迭代次数，返回当前最好的近似
+#define ROOT_NO_BRACKET 2 // 区间端点同号，无法保证收敛
+#define ROOT_ZERO_DERIVATIVE 3  // 无保护的牛顿迭代中导数为零，无法继续
+
+struct RootOptions {
+    double x_tol = 1e-14;  // 相对步长容限：|dx| <= x_tol * (1 + |x|)
+    double f_tol = 0.0;    // 函数值容限：|f| <= f_tol 视为收敛
+    int max_iter = 100;
+};
+
+struct RootResult {
+    double x;
+    double fx;
+    int iterations;
+    int status;
+};
+
+namespace roots_detail {
+
+template <class F, class = void>
+struct has_first_derivative : std::false_type {};
+template <class F>
+struct has_first_derivative<F, std::void_t<decltype(std::declval<F &>().eval(
+        0.0, std::declval<double &>(), std::declval<double &>()))>> : std::true_type {};
+
+template <class F, class = void>
+struct has_second_derivative : std::false_type {};
+template <class F>
+struct has_second_derivative<F, std::void_t<decltype(std::declval<F &>().eval(
+        0.0, std::declval<double &>(), std::declval<double &>(), std::declval<double &>()))>> : std::true_type {};
+
+// 只取函数值：有 operator() 用 operator()，否则从 eval 中取
+template <class F>
+double value(F &f, double x) {
+    if constexpr (std::is_invocable_r_v<double, F &, double>) {
+        return f(x);
+    } else if constexpr (has_second_derivative<F>::value && !has_first_derivative<F>::value) {
+        double fx, df, d2f;
+        f.eval(x, fx, df, d2f);
+        return fx;
+    } else {
+        double fx, df;
+        f.eval(x, fx, df);
+        return fx;
+    }
+}
+
+// 带保护的牛顿/哈雷迭代；Order 为 2 时用牛顿，为 3 时用哈雷
+template <int Order, class F>
+RootResult safeguarded(F &f, double lo, double hi, double x0, const RootOptions &opt) {
+    double flo = value(f, lo), fhi = value(f, hi);
+    if (flo == 0.0) return {lo, 0.0, 0, ROOT_CONVERGED};
+    if (fhi == 0.0) return {hi, 0.0, 0, ROOT_CONVERGED};
+    if ((flo > 0) == (fhi > 0)) return {x0, value(f, x0), 0, ROOT_NO_BRACKET};
+
+    // 令 f(xl) < 0 < f(xh)
+    double xl = flo < 0 ? lo : hi;
+    double xh = flo < 0 ? hi : lo;
+    double x = (x0 > std::fmin(lo, hi) && x0 < std::fmax(lo, hi)) ? x0 : 0.5 * (lo + hi);
+    double dx_old = std::fabs(hi - lo), dx = dx_old;
+    double fx, df, d2f = 0.0;
+    if constexpr (Order == 3) f.eval(x, fx, df, d2f); else f.eval(x, fx, df);
+
+    for (int iter = 1; iter <= opt.max_iter; iter++) {
+        double step = fx / df;
+        if constexpr (Order == 3) {
+            double denom = 1.0 - 0.5 * step * d2f / df;
+            if (std::fabs(denom) > 0.5) step /= denom;  // 哈雷修正过大时退回牛顿步
+        }
+        double candidate = x - step;
+        bool outside = !(candidate >= std::fmin(xl, xh) && candidate <= std::fmax(xl, xh));
+        bool too_slow = std::fabs(2.0 * fx) > std::fabs(dx_old * df);
+        dx_old = dx;
+        if (outside || too_slow || !std::isfinite(candidate)) {
+            dx = 0.5 * (xh - xl);  // 二分兜底
+            x = xl + dx;
+        } else {
+            dx = step;
+            x = candidate;
+        }
+        TRACE(TRACE_ROOT_NEWTON, iter, fx, dx);
+        if (std::fabs(dx) <= opt.x_tol * (1.0 + std::fabs(x))) {
+            return {x, value(f, x), iter, ROOT_CONVERGED};
+        }
+        if constexpr (Order == 3) f.eval(x, fx, df, d2f); else f.eval(x, fx, df);
+        if (std::fabs(fx) <= opt.f_tol || fx == 0.0) return {x, fx, iter, ROOT_CONVERGED};
+        if (fx < 0) xl = x; else xh = x;
+    }
+    return {x, fx, opt.max_iter, ROOT_MAX_ITER};
+}
+
+}  // namespace roots_detail
+
+// 带括区间保护的牛顿法：牛顿步越出区间或下降不够快时改为二分
+template <class F>
+RootResult newton_safe(F &f, double lo, double hi, double x0, const RootOptions &opt = RootOptions()) {
+    static_assert(roots_detail::has_first_derivative<F>::value, "newton_safe 需要 eval(x, f, df)");
+    return roots_detail::safeguarded<2>(f, lo, hi, x0, opt);
+}
+
+// 带括区间保护的哈雷法（三阶收敛）
+template <class F>
+RootResult halley_safe(F &f, double lo, double hi, double x0, const RootOptions &opt = RootOptions()) {
+    static_assert(roots_detail::has_second_derivative<F>::value, "halley_safe 需要 eval(x, f, df, d2f)");
+    return roots_detail::safeguarded<3>(f, lo, hi, x0, opt);
+}
+
+// Brent 法：逆二次插值 + 割线 + 二分，只需函数值
+template <class F>
+RootResult brent(F &f, double lo, double hi, const RootOptions &opt = RootOptions()) {
+    double a = lo, b = hi;
+    double fa = roots_detail::value(f, a), fb = roots_detail::value(f, b);
+    if (fa == 0.0) return {a, 0.0, 0, ROOT_CONVERGED};
+    if (fb == 0.0) return {b, 0.0, 0, ROOT_CONVERGED};
+    if ((fa > 0) == (fb > 0)) return {b, fb, 0, ROOT_NO_BRACKET};
+
+    double c = a, fc = fa, d = b - a, e = d;
+    for (int iter = 1; iter <= opt.max_iter; iter++) {
+        if ((fb > 0) == (fc > 0)) {
+            c = a;
+            fc = fa;
+            d = e = b - a;
+        }
+        if (std::fabs(fc) < std::fabs(fb)) {
+            a = b; b = c; c = a;
+            fa = fb; fb = fc; fc = fa;
+        }
+        double tol = 2.0 * 1.1e-16 * std::fabs(b) + 0.5 * opt.x_tol * (1.0 + std::fabs(b));
+        double m = 0.5 * (c - b);
+        if (std::fabs(m) <= tol || fb == 0.0 || std::fabs(fb) <= opt.f_tol) {
+            return {b, fb, iter, ROOT_CONVERGED};
+        }
+        if (std::fabs(e) >= tol && std::fabs(fa) > std::fabs(fb)) {
+            double s = fb / fa, p, q;
+            if (a == c) {
+                p = 2.0 * m * s;  // 割线
+                q = 1.0 - s;
+            } else {
+                double r = fb / fc, t = fa / fc;  // 逆二次插值
+                p = s * (2.0 * m * t * (t - r) - (b - a) * (r - 1.0));
+                q = (t - 1.0) * (r - 1.0) * (s - 1.0);
+            }
+            if (p > 0) q = -q; else p = -p;
+            if (2.0 * p < std::fmin(3.0 * m * q - std::fabs(tol * q), std::fabs(e * q))) {
+                e = d;
+                d = p / q;
+            } else {
+                d = m;
+                e = m;
+            }
+        } else {
+            d = m;
+            e = m;
+        }
+        a = b;
+        fa = fb;
+        double db = std::fabs(d) > tol ? d : (m > 0 ? tol : -tol);
+        b += db;
+        fb = roots_detail::value(f, b);
+        TRACE(TRACE_ROOT_BRENT, iter, fb, db);
+    }
+    return {b, fb, opt.max_iter, ROOT_MAX_ITER};
+}
+
+// 从 x0 出发按几何级数向两侧扩张，寻找变号区间；找不到返回 false
+template <class F>
+bool expand_bracket(F &f, double x0, double step, double &lo, double &hi, int max_expand = 60) {
+    lo = x0 - step;
+    hi = x0 + step;
+    double flo = roots_detail::value(f, lo), fhi = roots_detail::value(f, hi);
+    for (int k = 0; k < max_expand; k++) {
+        if ((flo > 0) != (fhi > 0) || flo == 0.0 || fhi == 0.0) return true;
+        if (std::fabs(flo) < std::fabs(fhi)) {
+            lo -= 1.6 * (hi - lo);
+            flo = roots_detail::value(f, lo);
+        } else {
+            hi += 1.6 * (hi - lo);
+            fhi = roots_detail::value(f, hi);
+        }
+    }
+    return false;
+}
+
+// 在 [lo, hi] 上求根，方法由函数对象提供的导数阶数在编译期决定
+template <class F>
+RootResult find_root(F &f, double lo, double hi, double x0, const RootOptions &opt = RootOptions()) {
+    if constexpr (roots_detail::has_second_derivative<F>::value) {
+        return halley_safe(f, lo, hi, x0, opt);
+    } else if constexpr (roots_detail::has_first_derivative<F>::value) {
+        return newton_safe(f, lo, hi, x0, opt);
+    } else {
+        return brent(f, lo, hi, opt);
+    }
+}
+
+// 只给初始猜测时：先扩张出变号区间再求根；扩张失败（如重根）时退化为不带保护的迭代，
+// 迭代中导数为零返回 ROOT_ZERO_DERIVATIVE，没有导数可用时返回 ROOT_NO_BRACKET
+template <class F>
+RootResult find_root_from_guess(F &f, double x0, const RootOptions &opt = RootOptions()) {
+    double lo, hi;
+    if (expand_bracket(f, x0, 1e-3 * (1.0 + std::fabs(x0)), lo, hi)) {
+        return find_root(f, lo, hi, x0, opt);
+    }
+    if constexpr (roots_detail::has_first_derivative<F>::value) {
+        double x = x0, fx, df;
+        for (int iter = 1; iter <= opt.max_iter; iter++) {
+            f.eval(x, fx, df);
+            if (df == 0.0) return {x, fx, iter, ROOT_ZERO_DERIVATIVE};
+            double dx = fx / df;
+            x -= dx;
+            TRACE(TRACE_ROOT_NEWTON, iter, fx, dx);
+            if (std::fabs(dx) <= opt.x_tol * (1.0 + std::fabs(x))) {
+                return {x, roots_detail::value(f, x), iter, ROOT_CONVERGED};
+            }
+        }
+        return {x, roots_detail::value(f, x), opt.max_iter, ROOT_MAX_ITER};
+    } else {
+        return {x0, roots_detail::value(f, x0), 0, ROOT_NO_BRACKET};
+    }
+}
+
+// 批量并行求解 n 个互不相关的方程：make(i) 返回第 i 个方程的函数对象
+template <class Make>
+void find_roots_batch(Make make, int n, const double *lo, const double *hi, const double *x0,
+                      RootResult *out, const RootOptions &opt = RootOptions()) {
+    #pragma omp parallel for schedule(dynamic, 256)
+    for (int i = 0; i < n; i++) {
+        auto f = make(i);
+        out[i] = find_root(f, lo[i], hi[i], x0 != nullptr ? x0[i] : 0.5 * (lo[i] + hi[i]), opt);
+    }
+}
+
+#endif // COMMON_ROOTS_HPP
@@ -0,0 +1,186 @@
+/**
+ * @Descripttion: 补偿求和与点积：Kahan/Neumaier、两两求和、分道 SIMD 补偿求和，以及与线程数无关的可复现并行归约
+ * @filename: sum.h
+ * @Author: 王春博
+ * @Date: 2026.10.19
+ * @Version: V1.0
+ *
+ * 第一周的结合律测试中 1e-10 + 1e10 - 1e10 会丢掉小项，这里的补偿算法能保住它。
+ * 分道版本用无分支的 TwoSum，不需要 -ffast-math 也能向量化。C 与 C++ 均可直接包含。
+ */
+
+#ifndef COMMON_SUM_H
+#define COMMON_SUM_H
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <math.h>
+
+#define SUM_LANES 8          // 分道求和的通道数
+#define SUM_PAIRWISE_BASE 128 // 两两求和的递归基块长度
+#define SUM_REPRO_BLOCK 4096  // 可复现并行归约的固定分块长度
+
+// 流式累加器：逐项加入，适合无法先存成数组的累加（如被积函数值、逐行误差）
+typedef struct {
+    double s;  // 部分和
+    double c;  // 累计的舍入误差
+} SumAcc;
+
+static inline SumAcc sum_acc_init(void) {
+    SumAcc acc = {0.0, 0.0};
+    return acc;
+}
+
+// Neumaier 改进的 Kahan 求和：新项比部分和大时也能正确补偿
+static inline void sum_acc_add(SumAcc *acc, double x) {
+    double t = acc->s + x;
+    if (fabs(acc->s) >= fabs(x)) {
+        acc->c += (acc->s - t) + x;
+    } else {
+        acc->c += (x - t) + acc->s;
+    }
+    acc->s = t;
+}
+
+// 合并两个累加器（部分和按 Neumaier 加入，误差项直接相加）
+static inline void sum_acc_merge(SumAcc *acc, SumAcc other) {
+    sum_acc_add(acc, other.s);
+    acc->c += other.c;
+}
+
+static inline double sum_acc_result(SumAcc acc) {
+    return acc.s + acc.c;
+}
+
+// 经典 Kahan 求和
+static inline double sum_kahan(const double *x, size_t n) {
+    double s = 0.0, c = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        double y = x[i] - c;
+        double t = s + y;
+        c = (t - s) - y;
+        s = t;
+    }
+    return s;
+}
+
+// Neumaier 求和
+static inline double sum_neumaier(const double *x, size_t n) {
+    SumAcc acc = sum_acc_init();
+    for (size_t i = 0; i < n; i++) sum_acc_add(&acc, x[i]);
+    return sum_acc_result(acc);
+}
+
+// 两两求和：误差界 O(log n)，基块内分道朴素累加
+static inline double sum_pairwise(const double *x, size_t n) {
+    if (n <= SUM_PAIRWISE_BASE) {
+        double lane[SUM_LANES] = {0};
+        size_t i = 0;
+        for (; i + SUM_LANES <= n; i += SUM_LANES) {
+            for (int k = 0; k < SUM_LANES; k++) lane[k] += x[i + k];
+        }
+        double s = 0.0;
+        for (; i < n; i++) s += x[i];
+        for (int k = 0; k < SUM_LANES; k++) s += lane[k];
+        return s;
+    }
+    size_t half = (n / 2 + SUM_LANES - 1) / SUM_LANES * SUM_LANES;
+    return sum_pairwise(x, half) + sum_pairwise(x + half, n - half);
+}
+
+// 分道补偿求和的核心：每个通道独立做 TwoSum，结果累加到 acc
+static inline void sum_lanes_twosum(const double *x, size_t n, SumAcc *acc) {
+    double s[SUM_LANES] = {0}, c[SUM_LANES] = {0};
+    size_t main_n = n - n % SUM_LANES;
+    for (size_t i = 0; i < main_n; i += SUM_LANES) {
+        for (int k = 0; k < SUM_LANES; k++) {
+            double t = s[k] + x[i + k];
+            double z = t - s[k];
+            c[k] += (s[k] - (t - z)) + (x[i + k] - z);
+            s[k] = t;
+        }
+    }
+    for (int k = 0; k < SUM_LANES; k++) {
+        sum_acc_add(acc, s[k]);
+        acc->c += c[k];
+    }
+    for (size_t i = main_n; i < n; i++) sum_acc_add(acc, x[i]);
+}
+
+// 分道 SIMD 补偿求和：精度与 Neumaier 相当，速度接近朴素求和
+static inline double sum_blocked(const double *x, size_t n) {
+    SumAcc acc = sum_acc_init();
+    sum_lanes_twosum(x, n, &acc);
+    return sum_acc_result(acc);
+}
+
+// 分道补偿点积：有硬件 FMA 时连乘积的舍入误差一起补偿（Dot2），否则只补偿加法
+static inline void sum_lanes_dot(const double *x, const double *y, size_t n, SumAcc *acc) {
+    double s[SUM_LANES] = {0}, c[SUM_LANES] = {0};
+    size_t main_n = n - n % SUM_LANES;
+    for (size_t i = 0; i < main_n; i += SUM_LANES) {
+        for (int k = 0; k < SUM_LANES; k++) {
+            double p = x[i + k] * y[i + k];
+#ifdef __FMA__
+            double ep = fma(x[i + k], y[i + k], -p);
+#else
+            double ep = 0.0;
+#endif
+            double t = s[k] + p;
+            double z = t - s[k];
+            c[k] += ((s[k] - (t - z)) + (p - z)) + ep;
+            s[k] = t;
+        }
+    }
+    for (int k = 0; k < SUM_LANES; k++) {
+        sum_acc_add(acc, s[k]);
+        acc->c += c[k];
+    }
+    for (size_t i = main_n; i < n; i++) sum_acc_add(acc, x[i] * y[i]);
+}
+
+static inline double sum_dot(const double *x, const double *y, size_t n) {
+    SumAcc acc = sum_acc_init();
+    sum_lanes_dot(x, y, n, &acc);
+    return sum_acc_result(acc);
+}
+
+// 可复现并行求和：固定长度分块、块内补偿求和、按块号顺序合并，结果与线程数逐位一致
+static inline double sum_reproducible(const double *x, size_t n) {
+    long blocks = (long) ((n + SUM_REPRO_BLOCK - 1) / SUM_REPRO_BLOCK);
+    if (blocks <= 1) return sum_blocked(x, n);
+    SumAcc *partial = (SumAcc *) malloc((size_t) blocks * sizeof(SumAcc));
+    if (partial == NULL) return sum_blocked(x, n);
+    #pragma omp parallel for schedule(static)
+    for (long k = 0; k < blocks; k++) {
+        size_t start = (size_t) k * SUM_REPRO_BLOCK;
+        size_t count = n - start < SUM_REPRO_BLOCK ? n - start : SUM_REPRO_BLOCK;
+        partial[k] = sum_acc_init();
+        sum_lanes_twosum(x + start, count, &partial[k]);
+    }
+    SumAcc acc = sum_acc_init();
+    for (long k = 0; k < blocks; k++) sum_acc_merge(&acc, partial[k]);
+    free(partial);
+    return sum_acc_result(acc);
+}
+
+// 可复现并行点积，分块与合并规则同上
+static inline double sum_dot_reproducible(const double *x, const double *y, size_t n) {
+    long blocks = (long) ((n + SUM_REPRO_BLOCK - 1) / SUM_REPRO_BLOCK);
+    if (blocks <= 1) return sum_dot(x, y, n);
+    SumAcc *partial = (SumAcc *) malloc((size_t) blocks * sizeof(SumAcc));
+    if (partial == NULL) return sum_dot(x, y, n);
+    #pragma omp parallel for schedule(static)
+    for (long k = 0; k < blocks; k++) {
+        size_t start = (size_t) k * SUM_REPRO_BLOCK;
+        size_t count = n - start < SUM_REPRO_BLOCK ? n - start : SUM_REPRO_BLOCK;
+        partial[k] = sum_acc_init();
+        sum_lanes_dot(x + start, y + start, count, &partial[k]);
+    }
+    SumAcc acc = sum_acc_init();
+    for (long k = 0; k < blocks; k++) sum_acc_merge(&acc, partial[k]);
+    free(partial);
+    return sum_acc_result(acc);
+}
+
+#endif // COMMON_SUM_H
@@ -0,0 +1,48 @@
+/**
+ * @Descripttion: 线性方程组演示程序共用的测试矩阵生成器，给定种子即可复现
+ * @filename: test_matrix.h
+ * @Author: 王春博
+ * @Date: 2026.10.19
+ * @Version: V1.0
+ *
+ * 矩阵按行指针传入（可直接传 Matrix.row），b 为右端项。C 与 C++ 均可直接包含。
+ */
+
+#ifndef COMMON_TEST_MATRIX_H
+#define COMMON_TEST_MATRIX_H
+
+#include <stdint.h>
+#include "rng.h"
+
+// 一般稠密矩阵：元素在 [-1, 1) 上均匀分布，不对角占优，结构检测不出捷径，消元必须选主元
+static inline void generate_dense_matrix(double **A, double *b, int n, uint64_t seed) {
+    Rng rng;
+    rng_init(&rng, seed);
+    for (int i = 0; i < n; i++) {
+        rng_fill_uniform(&rng, A[i], (size_t) n, -1.0, 1.0);
+        b[i] = rng_uniform_range(&rng, -1.0, 1.0);
+    }
+}
+
+// 稀疏上三角矩阵：对角元为 5 到 14 的整数，对角线以上每个元素以 sparsity 的概率取 1 到 5 的整数，其余为零；
+// b 为 1 到 10 的整数。对角元不为零，回代即可求解
+static inline void generate_sparse_upper_triangular_matrix(double **A, double *b, int n, double sparsity, uint64_t seed) {
+    Rng rng;
+    rng_init(&rng, seed);
+    for (int i = 0; i < n; i++) {
+        b[i] = rng_below(&rng, 10) + 1;
+        for (int j = 0; j < n; j++) {
+            if (j < i) {
+                A[i][j] = 0.0;
+            } else if (i == j) {
+                A[i][j] = rng_below(&rng, 10) + 5;
+            } else if (rng_uniform(&rng) < sparsity) {
+                A[i][j] = rng_below(&rng, 5) + 1;
+            } else {
+                A[i][j] = 0.0;
+            }
+        }
+    }
+}
+
+#endif // COMMON_TEST_MATRIX_H
@@ -0,0 +1,245 @@
+/**
+ * @Descripttion: 收敛轨迹记录：迭代循环把 (迭代号, 残差, 步长, 时间) 写入预分配的无锁环形缓冲区，后台线程转储为 CSV 或二进制文件
+ * @filename: trace.h
+ * @Author: 王春博
+ * @Date: 2026.10.19
+ * @Version: V1.0
+ *
+ * 迭代循环里逐次 printf 时，控制台 I/O 远比求解本身慢。这里的 TRACE(...) 只做一次写内存：
+ * 编译时定义 NUMERIC_TRACE（CMake 选项 -DNUMERIC_TRACE=ON）才生效，否则展开为空语句，参数也不求值。
+ *
+ * 环形缓冲区是单生产者单消费者的：生产者为调用 trace_set_ring() 的那个线程，消费者为转储线程；
+ * 其他线程上的 TRACE 不记录。缓冲区满时丢弃新记录并计数，不阻塞迭代。
+ * 二进制文件 = 8 字节文件头 "NTRACE1" + 若干 TraceRecord（本机字节序，每条 32 字节）。
+ * C 与 C++ 均可直接包含；POSIX 上用 pthread 转储，其他平台在 trace_session_end() 时一次写出。
+ */
+
+#ifndef COMMON_TRACE_H
+#define COMMON_TRACE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "bench.h"
+#if !defined(_WIN32)
+#include <pthread.h>
+#define TRACE_HAVE_THREAD 1
+#else
+#define TRACE_HAVE_THREAD 0
+#endif
+
+#ifdef NUMERIC_TRACE
+#define TRACE_ENABLED 1
+#define TRACE(stream, iter, residual, step) trace_record((stream), (iter), (residual), (step))
+#else
+#define TRACE_ENABLED 0
+#define TRACE(stream, iter, residual, step) ((void) 0)
+#endif
+
+// 记录来源，便于同一文件中区分不同的迭代
+#define TRACE_JACOBI 1       // 雅克比迭代：残差取 ||D^-1 (b - A x)||_1，恰等于步长
+#define TRACE_ROOT_NEWTON 2  // 带保护的牛顿 / 哈雷法：残差 f(x)，步长 dx
+#define TRACE_ROOT_BRENT 3   // Brent 法：残差 f(b)，步长为本次对 b 的修正量
+#define TRACE_ELLIPSE 4      // 点到椭圆的参数角牛顿修正：残差 f(θ)，步长 Δθ
+
+// 文件格式
+#define TRACE_CSV 0
+#define TRACE_BINARY 1
+
+#define TRACE_DEFAULT_CAPACITY (1 << 16)  // 默认缓冲区条数（2 MB）
+#define TRACE_CACHE_LINE 64
+
+#if defined(__GNUC__) || defined(__clang__)
+#define TRACE_LOAD_ACQUIRE(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define TRACE_STORE_RELEASE(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#else
+// x86 上普通读写即具有获取 / 释放语义，volatile 阻止编译器重排
+#define TRACE_LOAD_ACQUIRE(p) (*(volatile uint64_t *) (p))
+#define TRACE_STORE_RELEASE(p, v) (*(volatile uint64_t *) (p) = (v))
+#endif
+
+#if defined(__cplusplus)
+#define TRACE_THREAD_LOCAL thread_local
+#elif defined(_MSC_VER)
+#define TRACE_THREAD_LOCAL __declspec(thread)
+#else
+#define TRACE_THREAD_LOCAL _Thread_local
+#endif
+
+typedef struct {
+    int32_t stream;
+    int32_t iter;
+    double residual;
+    double step;
+    double time;  // 相对 trace_ring_init() 的秒数
+} TraceRecord;
+
+// head 只由生产者写，tail 只由消费者写，分处不同缓存行避免伪共享
+typedef struct {
+    TraceRecord *records;
+    uint64_t mask;  // 容量 - 1，容量为 2 的幂
+    double t0;
+    uint64_t dropped;
+    char pad0[TRACE_CACHE_LINE];
+    uint64_t head;
+    char pad1[TRACE_CACHE_LINE];
+    uint64_t tail;
+    char pad2[TRACE_CACHE_LINE];
+} TraceRing;
+
+static TRACE_THREAD_LOCAL TraceRing *trace_current_ring = NULL;
+
+// capacity 向上取整为 2 的幂；成功返回 0，内存不足返回 -1
+static inline int trace_ring_init(TraceRing *r, size_t capacity) {
+    size_t cap = 1;
+    while (cap < capacity) cap <<= 1;
+    r->records = (TraceRecord *) malloc(cap * sizeof(TraceRecord));
+    if (r->records == NULL) return -1;
+    r->mask = cap - 1;
+    r->t0 = bench_now();
+    r->dropped = 0;
+    r->head = 0;
+    r->tail = 0;
+    return 0;
+}
+
+static inline void trace_ring_free(TraceRing *r) {
+    free(r->records);
+    r->records = NULL;
+}
+
+static inline void trace_ring_push(TraceRing *r, int stream, int iter, double residual, double step) {
+    uint64_t head = r->head;
+    if (head - TRACE_LOAD_ACQUIRE(&r->tail) > r->mask) {
+        r->dropped++;
+        return;
+    }
+    TraceRecord *rec = &r->records[head & r->mask];
+    rec->stream = stream;
+    rec->iter = iter;
+    rec->residual = residual;
+    rec->step = step;
+    rec->time = bench_now() - r->t0;
+    TRACE_STORE_RELEASE(&r->head, head + 1);
+}
+
+// 取出至多 max 条记录，返回条数
+static inline size_t trace_ring_pop(TraceRing *r, TraceRecord *out, size_t max) {
+    uint64_t tail = r->tail;
+    uint64_t avail = TRACE_LOAD_ACQUIRE(&r->head) - tail;
+    size_t n = avail < max ? (size_t) avail : max;
+    for (size_t k = 0; k < n; k++) out[k] = r->records[(tail + k) & r->mask];
+    TRACE_STORE_RELEASE(&r->tail, tail + n);
+    return n;
+}
+
+// 指定当前线程的 TRACE 写入哪个缓冲区，NULL 表示不记录
+static inline void trace_set_ring(TraceRing *r) {
+    trace_current_ring = r;
+}
+
+static inline void trace_record(int stream, int iter, double residual, double step) {
+    TraceRing *r = trace_current_ring;
+    if (r != NULL) trace_ring_push(r, stream, iter, residual, step);
+}
+
+static inline void trace_write_header(FILE *file, int format) {
+    if (format == TRACE_BINARY) {
+        fwrite("NTRACE1", 1, 8, file);
+    } else {
+        fprintf(file, "stream,iter,residual,step,time_s\n");
+    }
+}
+
+static inline void trace_write_records(FILE *file, int format, const TraceRecord *rec, size_t n) {
+    if (format == TRACE_BINARY) {
+        fwrite(rec, sizeof(TraceRecord), n, file);
+        return;
+    }
+    for (size_t k = 0; k < n; k++) {
+        fprintf(file, "%d,%d,%.17g,%.17g,%.9f\n", rec[k].stream, rec[k].iter, rec[k].residual, rec[k].step,
+                rec[k].time);
+    }
+}
+
+// 一次记录会话：缓冲区 + 输出文件 + 转储线程
+typedef struct {
+    TraceRing ring;
+    FILE *file;
+    int format;
+    int active;
+    int stop;
+    long written;
+#if TRACE_HAVE_THREAD
+    pthread_t thread;
+    int threaded;
+#endif
+} TraceSession;
+
+// 把缓冲区中已有的记录全部写出，返回条数
+static inline long trace_session_flush(TraceSession *s) {
+    TraceRecord chunk[256];
+    long total = 0;
+    size_t n;
+    while ((n = trace_ring_pop(&s->ring, chunk, 256)) > 0) {
+        trace_write_records(s->file, s->format, chunk, n);
+        total += (long) n;
+    }
+    s->written += total;
+    return total;
+}
+
+#if TRACE_HAVE_THREAD
+static inline void *trace_session_worker(void *arg) {
+    TraceSession *s = (TraceSession *) arg;
+    while (!__atomic_load_n(&s->stop, __ATOMIC_ACQUIRE)) {
+        if (trace_session_flush(s) == 0) {
+            struct timespec pause = {0, 1000000};  // 空闲时每毫秒查看一次
+            nanosleep(&pause, NULL);
+        }
+    }
+    return NULL;
+}
+#endif
+
+// 开始记录当前线程的 TRACE：未启用 NUMERIC_TRACE 时什么也不做，返回 0；
+// 启用时打开 path 并启动转储线程，失败返回 -1（此时 TRACE 不记录）
+static inline int trace_session_begin(TraceSession *s, const char *path, int format) {
+    s->active = 0;
+    s->written = 0;
+    if (!TRACE_ENABLED) return 0;
+    s->file = fopen(path, format == TRACE_BINARY ? "wb" : "w");
+    if (s->file == NULL) return -1;
+    if (trace_ring_init(&s->ring, TRACE_DEFAULT_CAPACITY) != 0) {
+        fclose(s->file);
+        return -1;
+    }
+    s->format = format;
+    s->stop = 0;
+    s->active = 1;
+    trace_write_header(s->file, format);
+#if TRACE_HAVE_THREAD
+    s->threaded = pthread_create(&s->thread, NULL, trace_session_worker, s) == 0;
+#endif
+    trace_set_ring(&s->ring);
+    return 0;
+}
+
+// 结束记录：停止转储线程，写出剩余记录并关闭文件；返回写出的条数，丢弃的条数见 s->ring.dropped
+static inline long trace_session_end(TraceSession *s) {
+    if (!s->active) return 0;
+    trace_set_ring(NULL);
+#if TRACE_HAVE_THREAD
+    if (s->threaded) {
+        __atomic_store_n(&s->stop, 1, __ATOMIC_RELEASE);
+        pthread_join(s->thread, NULL);
+    }
+#endif
+    trace_session_flush(s);
+    fclose(s->file);
+    trace_ring_free(&s->ring);
+    s->active = 0;
+    return s->written;
+}
+
+#endif // COMMON_TRACE_H
@@ -9,127 +9,103 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
-#include <time.h>
+#include <float.h>
+#include <string.h>
+#include "common/sum.h"
+#include "common/banded.h"
+#include "common/bench.h"
+#include "common/matrix.h"
+#include "common/test_matrix.h"
+#include "第四周/lu.hpp"
 
 #define N 1000     // 矩阵阶数
 #define SPARSITY 0.05  // 稀疏度，表示非零元素占总元素的比例
+#define SEED 20241015  // 随机数种子，保证生成的测试矩阵可复现
+#define PRINT_COUNT 10  // 输出解向量的前几个分量
 
-// 函数：生成稀疏上三角矩阵
-void generate_sparse_upper_triangular_matrix(double **A, double *b) {
-    srand(time(NULL));  // 初始化随机数种子
-
-    // 初始化稀疏矩阵
+// 函数：评估准确性
+double evaluate_accuracy(const double *x, const double *b, double **A) {
+    SumAcc error_sum = sum_acc_init();
     for (int i = 0; i < N; i++) {
-        b[i] = rand() % 10 + 1;  // 随机生成b向量
-
-        for (int j = 0; j < N; j++) {
-            if (j < i) {
-                A[i][j] = 0.0;  // 确保是上三角矩阵，主对角线以下的元素为0
-            } else if (i == j) {
-                A[i][j] = rand() % 10 + 5;  // 确保对角线上的元素较大，且不为零
-            } else if ((double) rand() / RAND_MAX < SPARSITY) {
-                A[i][j] = rand() % 5 + 1;  // 随机生成上三角区域的稀疏元素
-            } else {
-                A[i][j] = 0.0;  // 稀疏矩阵的其他位置为0
-            }
-        }
+        double calculated_b = sum_dot(A[i], x, N);  // 计算 Ax_i（补偿点积）
+        sum_acc_add(&error_sum, fabs(b[i] - calculated_b));  // 计算 b - Ax 的绝对误差和
     }
+    return sum_acc_result(error_sum);
 }
 
-// 高斯消去法
-void gaussian_elimination(double **A, double *b, double *x) {
-    // 消元阶段
-    for (int i = 0; i < N; i++) {
-        // 如果主元为 0，交换行
-        if (A[i][i] == 0) {
-            for (int k = i + 1; k < N; k++) {
-                if (A[k][i] != 0) {
-                    for (int j = 0; j < N; j++) {
-                        double temp = A[i][j];
-                        A[i][j] = A[k][j];
-                        A[k][j] = temp;
-                    }
-                    double temp_b = b[i];
-                    b[i] = b[k];
-                    b[k] = temp_b;
-                    break;
-                }
-            }
-        }
-
-        for (int j = i + 1; j < N; j++) {
-            double rate = A[j][i] / A[i][i];
-            for (int k = i; k < N; k++) {
-                A[j][k] -= rate * A[i][k];
-            }
-            b[j] -= rate * b[i];
-        }
-    }
+// 求解一个算例：先检测结构，三角、三对角、窄带矩阵走快速路径，只有一般稠密矩阵才用 lu.hpp 做选主元 LU 分解
+// A 会被分解覆盖，A0 保留一份原矩阵用于最后的残差检验；成功返回 0，奇异或内存不足返回 -1
+int solve_case(const char *title, Matrix *a, Matrix *a0, const double *b, double *x, int *perm) {
+    double anorm = lu_norm1(a->data, N, a->ld);
+    matrix_copy(a0, a);
+    printf("== %s ==\n", title);
 
-    // 回代阶段
-    for (int i = N - 1; i >= 0; i--) {
-        x[i] = b[i];
-        for (int j = i + 1; j < N; j++) {
-            x[i] -= A[i][j] * x[j];
-        }
-        x[i] /= A[i][i];
-    }
-}
-
-// 函数：评估准确性
-double evaluate_accuracy(double *x, double *b, double **A) {
-    double error_sum = 0.0;
-    for (int i = 0; i < N; i++) {
-        double calculated_b = 0.0;
-        for (int j = 0; j < N; j++) {
-            calculated_b += A[i][j] * x[j];  // 计算 Ax_i
+    // 开始计时
+    double start_time = bench_now();
+
+    int structure;
+    double growth = 0.0;
+    int info = structured_solve(a->row, N, b, x, &structure);
+    int dense = info == -1;
+    if (dense) {
+        info = lu_factor(a->data, N, a->ld, perm, &growth);
+        if (info == 0) {
+            memcpy(x, b, N * sizeof(double));
+            lu_solve(a->data, N, a->ld, perm, x);
         }
-        error_sum += fabs(b[i] - calculated_b);  // 计算 b - Ax 的绝对误差和
     }
-    return error_sum;
-}
 
-int main() {
-    double **A = (double **)malloc(N * sizeof(double *));
-    for (int i = 0; i < N; i++) {
-        A[i] = (double *)malloc(N * sizeof(double));
-    }
-    double *b = (double *)malloc(N * sizeof(double));
-    double *x = (double *)malloc(N * sizeof(double));  // 解向量
-
-    if (A == NULL || b == NULL || x == NULL) {
-        printf("内存分配失败\n");
+    // 结束计时
+    double elapsed_time = bench_now() - start_time;
+    printf("矩阵结构: %s\n", matrix_structure_name(structure));
+    printf("求解运行时间: %f 秒\n", elapsed_time);
+    if (info != 0) {
+        printf(info == -2 ? "内存不足，无法求解\n" : "矩阵奇异，无法求解\n");
         return -1;
     }
 
-    // 调用生成稀疏上三角矩阵的函数
-    generate_sparse_upper_triangular_matrix(A, b);
-
-    // 开始计时
-    clock_t start_time = clock();
-
-    // 使用高斯消去法求解
-    gaussian_elimination(A, b, x);
-
-    // 结束计时
-    clock_t end_time = clock();
-    double elapsed_time = (double)(end_time - start_time) / CLOCKS_PER_SEC;
-    printf("高斯消去法运行时间: %f 秒\n", elapsed_time);
+    if (dense) {
+        // O(N^2) 的精度监控：相对误差约为 条件数 * 增长因子 * 机器精度
+        double cond = lu_condest(a->data, N, a->ld, perm, anorm);
+        printf("主元增长因子: %e, 条件数估计: %e, 相对误差界约: %e\n", growth, cond, cond * growth * DBL_EPSILON);
+    }
 
-    // 评估解的准确性
-    double accuracy = evaluate_accuracy(x, b, A);
-    printf("解的准确性误差总和: %f\n", accuracy);
+    // 评估解的准确性（O(N^2) 的完整矩阵向量乘，仅作核对）
+    double accuracy = evaluate_accuracy(x, b, a0->row);
+    printf("解的准确性误差总和: %e\n", accuracy);
 
-    for (int i = 0; i < N; i++) {
+    // 逐个打印 1000 个分量比求解本身还慢，只看前几个
+    for (int i = 0; i < PRINT_COUNT; i++) {
         printf("x[%d] = %f\n", i, x[i]);
     }
+    return 0;
+}
 
-    for (int i = 0; i < N; i++) {
-        free(A[i]);
+int main() {
+    // 矩阵连续存放；A0 保存分解前的副本
+    Matrix a, a0;
+    int ok_a = matrix_alloc(&a, N, N) == 0, ok_a0 = matrix_alloc(&a0, N, N) == 0;
+    double *b = vector_alloc(N);
+    double *x = vector_alloc(N);  // 解向量
+    int *perm = (int *)malloc(N * sizeof(int));  // 行排列
+
+    int failed = !ok_a || !ok_a0 || b == NULL || x == NULL || perm == NULL;
+    if (failed) {
+        printf("内存分配失败\n");
+    } else {
+        // 稀疏上三角矩阵：结构检测直接回代
+        generate_sparse_upper_triangular_matrix(a.row, b, N, SPARSITY, SEED);
+        failed |= solve_case("稀疏上三角矩阵", &a, &a0, b, x, perm) != 0;
+        // 一般稠密矩阵：选主元 LU 分解与条件数估计
+        generate_dense_matrix(a.row, b, N, SEED);
+        failed |= solve_case("一般稠密矩阵", &a, &a0, b, x, perm) != 0;
     }
-    free(A);
-    free(b);
-    free(x);
 
-    return 0;
+    matrix_free(&a);
+    matrix_free(&a0);
+    vector_free(b);
+    vector_free(x);
+    free(perm);
+
+    return failed ? -1 : 0;
 }
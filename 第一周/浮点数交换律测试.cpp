@@ -3,7 +3,6 @@
 //  Description: 浮点数交换律测试
 
 
-#include "浮点数交换律测试.h"
 #include<iostream>
 
 int main() {
@@ -2,7 +2,6 @@
 //  Date: 2024/9/3
 //  Description: 浮点数结合律测试
 
-#include "浮点数结合律测试.h"
 #include<iostream>
 
 int main() {
@@ -0,0 +1,85 @@
+//  Author: 王春博
+//  Date: 2026/10/19
+//  Description: 补偿求和测试：精度、速度，以及并行归约结果与线程数无关
+
+#include<iostream>
+#include<iomanip>
+#include<chrono>
+#include<vector>
+#include<cmath>
+#ifdef _OPENMP
+#include<omp.h>
+#endif
+#include "../common/sum.h"
+#include "../common/rng.h"
+
+template <class Fn>
+double best_time(Fn fn, int repeat) {
+    double best = 1e30;
+    for (int r = 0; r < repeat; r++) {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        auto end = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double>(end - start).count());
+    }
+    return best;
+}
+
+int main() {
+    // 结合律测试中的例子：朴素求和丢掉 1e-10
+    double abc[3] = {1e-10, 1e10, -1e10};
+    std::cout << std::setprecision(17);
+    std::cout << "naive:     " << abc[0] + abc[1] + abc[2] << std::endl;
+    std::cout << "kahan:     " << sum_kahan(abc, 3) << std::endl;
+    std::cout << "neumaier:  " << sum_neumaier(abc, 3) << std::endl;
+    std::cout << "blocked:   " << sum_blocked(abc, 3) << std::endl;
+
+    // 病态求和：big, 1, -big 交替出现，大数超过 2^53 后朴素求和会把 1 吞掉，精确和为三元组个数
+    const size_t n = 3 << 22;
+    std::vector<double> x(n), y(n);
+    for (size_t i = 0; i < n; i += 3) {
+        double big = 1e17 * (1.0 + (double) i / n);
+        x[i] = big;
+        x[i + 1] = 1.0;
+        x[i + 2] = -big;
+    }
+    double exact = (double) (n / 3);
+    double naive = 0.0;
+    for (size_t i = 0; i < n; i++) naive += x[i];
+    std::cout << "病态求和 精确值 " << exact << std::endl;
+    std::cout << "  naive     " << naive << std::endl;
+    std::cout << "  pairwise  " << sum_pairwise(x.data(), n) << std::endl;
+    std::cout << "  neumaier  " << sum_neumaier(x.data(), n) << std::endl;
+    std::cout << "  blocked   " << sum_blocked(x.data(), n) << std::endl;
+    std::cout << "  repro     " << sum_reproducible(x.data(), n) << std::endl;
+
+    // 速度：均匀随机数据
+    rng_fill_uniform_parallel(7, x.data(), n, -1, 1);
+    rng_fill_uniform_parallel(8, y.data(), n, -1, 1);
+    volatile double sink = 0.0;
+    double t_naive = best_time([&] {
+        double s = 0.0;
+        for (size_t i = 0; i < n; i++) s += x[i];
+        sink = s;
+    }, 5);
+    double t_kahan = best_time([&] { sink = sum_kahan(x.data(), n); }, 5);
+    double t_pair = best_time([&] { sink = sum_pairwise(x.data(), n); }, 5);
+    double t_block = best_time([&] { sink = sum_blocked(x.data(), n); }, 5);
+    double t_repro = best_time([&] { sink = sum_reproducible(x.data(), n); }, 5);
+    double t_dot = best_time([&] { sink = sum_dot(x.data(), y.data(), n); }, 5);
+    std::cout << std::setprecision(4);
+    std::cout << "速度 (GB/s): naive " << n * 8 / t_naive / 1e9 << ", kahan " << n * 8 / t_kahan / 1e9
+              << ", pairwise " << n * 8 / t_pair / 1e9 << ", blocked " << n * 8 / t_block / 1e9
+              << ", reproducible " << n * 8 / t_repro / 1e9 << ", dot " << n * 16 / t_dot / 1e9 << std::endl;
+
+    // 可复现性：不同线程数下结果逐位相同
+    std::cout << std::setprecision(17);
+    for (int threads = 1; threads <= 8; threads *= 2) {
+#ifdef _OPENMP
+        omp_set_num_threads(threads);
+#endif
+        std::cout << "threads = " << threads << ": sum = " << sum_reproducible(x.data(), n)
+                  << ", dot = " << sum_dot_reproducible(x.data(), y.data(), n) << std::endl;
+    }
+    return 0;
+}
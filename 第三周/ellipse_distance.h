@@ -0,0 +1,117 @@
+/**
+ * @Author: 王春博
+ * @Date: 2026.10.19
+ * @Description: 批量求点到椭圆的最近点与距离（SoA 数组，跨查询 SIMD，迭代次数固定，无 I/O）
+ *
+ * 算法：先在椭圆的渐屈线上做固定 3 次的曲率圆迭代得到初值，
+ * 再对参数角做 2 次带保护的牛顿修正，全程无数据相关分支，便于编译器向量化。
+ * 定义 NUMERIC_TRACE 时单点求解 ellipse_closest_point 会记录牛顿修正的轨迹；批量求解传 trace = 0，
+ * 内联后记录调用被消去，simd 循环中没有副作用，开启追踪也不影响向量化。
+ * C 与 C++ 均可直接包含；需配合 -fno-math-errno -fno-trapping-math 编译才能真正向量化。
+ */
+
+#ifndef ELLIPSE_DISTANCE_H
+#define ELLIPSE_DISTANCE_H
+
+#include <math.h>
+#include "../common/trace.h"
+
+#define ELLIPSE_EVOLUTE_ITERS 3  // 渐屈线迭代次数
+#define ELLIPSE_NEWTON_ITERS 2   // 参数角牛顿修正次数
+
+// 一批椭圆的参数（结构数组）：中心、旋转角的余弦/正弦、两个半轴
+typedef struct {
+    const double *cx;
+    const double *cy;
+    const double *cos_t;
+    const double *sin_t;
+    const double *a;
+    const double *b;
+} EllipseSoA;
+
+// 用比较实现截断而不用 fmin/fmax，后者因 NaN 语义无法直接向量化
+static inline double ellipse_clamp01(double x) {
+    x = x > 0.0 ? x : 0.0;
+    return x < 1.0 ? x : 1.0;
+}
+
+// 标准位置椭圆 x^2/a^2 + y^2/b^2 = 1 上离 (u, v) 最近的点；trace 非 0 时记录牛顿修正的轨迹，simd 循环中必须传常量 0
+static inline void ellipse_closest_point_core(double u, double v, double a, double b, double *x, double *y, int trace) {
+    double pu = fabs(u), pv = fabs(v);
+    double c = 0.7071067811865476, s = 0.7071067811865476;  // 参数角的余弦、正弦
+    double k = a * a - b * b;
+
+    // 渐屈线迭代：以当前点的曲率中心为圆心，把查询点投影回椭圆
+    for (int it = 0; it < ELLIPSE_EVOLUTE_ITERS; it++) {
+        double ex = k * c * c * c / a;
+        double ey = -k * s * s * s / b;
+        double rx = a * c - ex, ry = b * s - ey;
+        double qx = pu - ex, qy = pv - ey;
+        double r = sqrt(rx * rx + ry * ry);
+        double q = sqrt(qx * qx + qy * qy);
+        q = q > 1e-300 ? q : 1e-300;
+        c = ellipse_clamp01((qx * r / q + ex) / a);
+        s = ellipse_clamp01((qy * r / q + ey) / b);
+        double t = sqrt(c * c + s * s);
+        t = t > 1e-300 ? t : 1e-300;
+        c /= t;
+        s /= t;
+    }
+
+    // 牛顿修正：f(θ) = k cosθ sinθ - u a sinθ + v b cosθ，只在距离不增大时接受
+    for (int it = 0; it < ELLIPSE_NEWTON_ITERS; it++) {
+        double f = k * c * s - pu * a * s + pv * b * c;
+        double fp = k * (c * c - s * s) - pu * a * c - pv * b * s;
+        double step = (fabs(fp) > 1e-300) ? -f / fp : 0.0;
+        double nc = c - s * step, ns = s + c * step;
+        double t = sqrt(nc * nc + ns * ns);
+        nc = ellipse_clamp01(nc / t);
+        ns = ellipse_clamp01(ns / t);
+        double d_old = (a * c - pu) * (a * c - pu) + (b * s - pv) * (b * s - pv);
+        double d_new = (a * nc - pu) * (a * nc - pu) + (b * ns - pv) * (b * ns - pv);
+        int accept = d_new <= d_old;
+        c = accept ? nc : c;
+        s = accept ? ns : s;
+        if (trace) TRACE(TRACE_ELLIPSE, it, f, step);
+    }
+
+    *x = copysign(a * c, u);
+    *y = copysign(b * s, v);
+}
+
+// 单点求解，记录轨迹
+static inline void ellipse_closest_point(double u, double v, double a, double b, double *x, double *y) {
+    ellipse_closest_point_core(u, v, a, b, x, y, 1);
+}
+
+// 批量求解：第 i 个点对应第 i 个标准位置椭圆 (a[i], b[i])；qx/qy 可为 NULL
+static inline void ellipse_distance_batch(const double *px, const double *py, const double *a, const double *b,
+                                          int n, double *qx, double *qy, double *dist) {
+    #pragma omp parallel for simd schedule(static)
+    for (int i = 0; i < n; i++) {
+        double x, y;
+        ellipse_closest_point_core(px[i], py[i], a[i], b[i], &x, &y, 0);
+        dist[i] = sqrt((x - px[i]) * (x - px[i]) + (y - py[i]) * (y - py[i]));
+        if (qx != NULL) qx[i] = x;
+        if (qy != NULL) qy[i] = y;
+    }
+}
+
+// 批量求解一般位置的椭圆：先把查询点变换到椭圆的局部坐标系，求解后再变换回去
+static inline void ellipse_distance_batch_general(const double *px, const double *py, const EllipseSoA *e,
+                                                  int n, double *qx, double *qy, double *dist) {
+    const double *cx = e->cx, *cy = e->cy, *ct = e->cos_t, *st = e->sin_t, *a = e->a, *b = e->b;
+    #pragma omp parallel for simd schedule(static)
+    for (int i = 0; i < n; i++) {
+        double dx = px[i] - cx[i], dy = py[i] - cy[i];
+        double u = ct[i] * dx + st[i] * dy;
+        double v = -st[i] * dx + ct[i] * dy;
+        double x, y;
+        ellipse_closest_point_core(u, v, a[i], b[i], &x, &y, 0);
+        dist[i] = sqrt((x - u) * (x - u) + (y - v) * (y - v));
+        if (qx != NULL) qx[i] = cx[i] + ct[i] * x - st[i] * y;
+        if (qy != NULL) qy[i] = cy[i] + st[i] * x + ct[i] * y;
+    }
+}
+
+#endif // ELLIPSE_DISTANCE_H
@@ -0,0 +1,95 @@
+/**
+* @Author: 王春博
+ * @Date: 2026.10.19
+ * @Description: 数值计算与算法：批量求解点到椭圆的最小距离，并与逐点稠密搜索的结果对比
+ */
+#include <cstdio>
+#include <cmath>
+#include <chrono>
+#include <vector>
+#include "ellipse_distance.h"
+#include "../common/rng.h"
+
+// 参考解：在第一象限参数角上稠密采样，再用黄金分割细化
+double reference_distance(double u, double v, double a, double b) {
+    u = fabs(u);
+    v = fabs(v);
+    auto d2 = [&](double t) {
+        double x = a * cos(t) - u, y = b * sin(t) - v;
+        return x * x + y * y;
+    };
+    const int samples = 4096;
+    double best_t = 0.0, best = d2(0.0);
+    for (int i = 1; i <= samples; i++) {
+        double t = M_PI / 2 * i / samples;
+        if (d2(t) < best) {
+            best = d2(t);
+            best_t = t;
+        }
+    }
+    double lo = fmax(best_t - M_PI / 2 / samples, 0.0), hi = fmin(best_t + M_PI / 2 / samples, M_PI / 2);
+    const double g = 0.6180339887498949;
+    for (int it = 0; it < 100; it++) {
+        double m1 = hi - g * (hi - lo), m2 = lo + g * (hi - lo);
+        if (d2(m1) < d2(m2)) hi = m2; else lo = m1;
+    }
+    return sqrt(fmin(best, d2(0.5 * (lo + hi))));
+}
+
+int main() {
+    const int n = 4000000;
+    Rng rng;
+    rng_init(&rng, 20240923);
+
+    std::vector<double> px(n), py(n), a(n), b(n), dist(n);
+    for (int i = 0; i < n; i++) {
+        a[i] = rng_uniform_range(&rng, 1, 100);
+        b[i] = rng_uniform_range(&rng, 1, 100);
+        // 一半查询点远离椭圆，一半落在椭圆附近（含内部），覆盖最难的情形
+        if (i % 2 == 0) {
+            px[i] = rng_uniform_range(&rng, -1000, 1000);
+            py[i] = rng_uniform_range(&rng, -1000, 1000);
+        } else {
+            px[i] = a[i] * rng_uniform_range(&rng, -1.5, 1.5);
+            py[i] = b[i] * rng_uniform_range(&rng, -1.5, 1.5);
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    ellipse_distance_batch(px.data(), py.data(), a.data(), b.data(), n, nullptr, nullptr, dist.data());
+    auto end = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+    printf("批量求解 %d 个查询: %.4f 秒, %.2f M 查询/秒\n", n, seconds, n / seconds / 1e6);
+
+    // 抽样检验精度
+    double max_err = 0.0;
+    for (int i = 0; i < n; i += n / 2000) {
+        double ref = reference_distance(px[i], py[i], a[i], b[i]);
+        max_err = fmax(max_err, (dist[i] - ref) / fmax(1.0, ref));
+    }
+    printf("抽样最大相对误差（正值表示比参考解差）: %.3e\n", max_err);
+
+    // 一般位置的椭圆：平移 + 旋转
+    std::vector<double> cx(n), cy(n), ct(n), st(n), qx(n), qy(n), dist2(n);
+    for (int i = 0; i < n; i++) {
+        double theta = rng_uniform_range(&rng, 0, 2 * M_PI);
+        cx[i] = rng_uniform_range(&rng, -1000, 1000);
+        cy[i] = rng_uniform_range(&rng, -1000, 1000);
+        ct[i] = cos(theta);
+        st[i] = sin(theta);
+    }
+    EllipseSoA e = {cx.data(), cy.data(), ct.data(), st.data(), a.data(), b.data()};
+    std::vector<double> gx(n), gy(n);
+    for (int i = 0; i < n; i++) {
+        gx[i] = cx[i] + ct[i] * px[i] - st[i] * py[i];
+        gy[i] = cy[i] + st[i] * px[i] + ct[i] * py[i];
+    }
+    start = std::chrono::steady_clock::now();
+    ellipse_distance_batch_general(gx.data(), gy.data(), &e, n, qx.data(), qy.data(), dist2.data());
+    end = std::chrono::steady_clock::now();
+    seconds = std::chrono::duration<double>(end - start).count();
+    double max_diff = 0.0;
+    for (int i = 0; i < n; i++) max_diff = fmax(max_diff, fabs(dist2[i] - dist[i]) / fmax(1.0, dist[i]));
+    printf("一般位置椭圆 %d 个查询: %.4f 秒, 与标准位置结果的最大相对差: %.3e\n", n, seconds, max_diff);
+    return 0;
+}
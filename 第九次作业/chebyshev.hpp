@@ -0,0 +1,202 @@
+/**
+ * @Descripttion: 切比雪夫逼近：在切比雪夫点上采样，用 FFT 实现的 DCT 一次得到全部系数，自适应截断次数，Clenshaw 批量求值
+ * @filename: chebyshev.hpp
+ * @Author: 王春博
+ * @Date: 2026.10.19
+ * @Version: V1.0
+ *
+ * 采样点取第二类切比雪夫点 x_j = cos(πj/n)，j = 0..n。插值多项式的系数是采样值的 I 型离散余弦变换：
+ *   c_k = (2/n) Σ'' f_j cos(πjk/n)，c_0、c_n 再减半（Σ'' 表示首末两项减半）
+ * 它等于偶延拓序列长为 2n 的 FFT 的实部除以 n，代价 O(n log n)；逐个系数做数值积分则是 O(n) 次积分。
+ * n 翻倍时旧点恰为新点中的偶数号点，自适应加密只需计算新增的一半函数值。
+ * 截断规则：系数尾部连续一段都低于 tol * max|c_k| 即认为已收敛，保留到最后一个超过阈值的系数。
+ */
+
+#ifndef CHEBYSHEV_HPP
+#define CHEBYSHEV_HPP
+
+#include <cmath>
+#include <complex>
+#include <vector>
+#include "../common/poly.hpp"
+
+#define CHEBYSHEV_MIN_POINTS 16       // 自适应起步的 n
+#define CHEBYSHEV_MAX_POINTS 65536    // 自适应的 n 上限
+#define CHEBYSHEV_TAIL 8              // 判定收敛时要求尾部连续小于阈值的系数个数
+#define CHEBYSHEV_BLOCK 16            // Clenshaw 批量求值时一次处理的点数
+#define CHEBYSHEV_PARALLEL_MIN 4096   // 采样点数或求值点数达到此数才并行
+
+struct ChebyshevOptions {
+    double tol = 2.2e-16 * 16;           // 相对容限（相对于最大系数）
+    int max_points = CHEBYSHEV_MAX_POINTS;
+};
+
+// [lo, hi] 上的切比雪夫级数 Σ coef[k] T_k(t)，t = (2x - lo - hi) / (hi - lo)
+// status 为 0 表示截断规则判定收敛，1 表示达到 max_points 仍未收敛（系数照常可用），-1 表示参数非法
+struct ChebyshevSeries {
+    double lo = -1.0;
+    double hi = 1.0;
+    std::vector<double> coef;
+    long evaluations = 0;
+    int status = -1;
+
+    int degree() const { return (int) coef.size() - 1; }
+    double operator()(double x) const;
+    void eval(const double *x, double *y, int n) const;
+    ChebyshevSeries truncated(int degree) const;
+};
+
+namespace chebyshev_detail {
+
+inline bool power_of_two(int n) {
+    return n > 0 && (n & (n - 1)) == 0;
+}
+
+// 原地迭代基 2 FFT，n 为 2 的幂
+inline void fft(std::vector<std::complex<double>> &a) {
+    int n = (int) a.size();
+    for (int i = 1, j = 0; i < n; i++) {
+        int bit = n >> 1;
+        for (; j & bit; bit >>= 1) j ^= bit;
+        j ^= bit;
+        if (i < j) std::swap(a[i], a[j]);
+    }
+    for (int len = 2; len <= n; len <<= 1) {
+        double angle = -2.0 * M_PI / len;
+        std::vector<std::complex<double>> w(len / 2);
+        for (int k = 0; k < len / 2; k++) w[k] = std::complex<double>(std::cos(angle * k), std::sin(angle * k));
+        for (int i = 0; i < n; i += len) {
+            for (int k = 0; k < len / 2; k++) {
+                std::complex<double> u = a[i + k], v = a[i + k + len / 2] * w[k];
+                a[i + k] = u + v;
+                a[i + k + len / 2] = u - v;
+            }
+        }
+    }
+}
+
+// 尾部检测：返回应保留的次数，未收敛返回 -1
+inline int chop(const std::vector<double> &c, double tol) {
+    double scale = 0.0;
+    for (double v : c) scale = std::fmax(scale, std::fabs(v));
+    if (scale == 0.0) return 0;
+    double threshold = tol * scale;
+    int n = (int) c.size();
+    int last = n - 1;
+    while (last >= 0 && std::fabs(c[last]) <= threshold) last--;
+    if (n - 1 - last < CHEBYSHEV_TAIL) return -1;
+    return last < 0 ? 0 : last;
+}
+
+}  // namespace chebyshev_detail
+
+// 由 n + 1 个第二类切比雪夫点（x_j = cos(πj/n)，从 1 到 -1）上的函数值求插值系数；n 须为 2 的幂
+inline std::vector<double> chebyshev_coefficients(const double *values, int n) {
+    if (n == 0) return std::vector<double>(1, values[0]);
+    std::vector<std::complex<double>> v(2 * n);
+    for (int j = 0; j <= n; j++) v[j] = values[j];
+    for (int j = 1; j < n; j++) v[2 * n - j] = values[j];
+    chebyshev_detail::fft(v);
+    std::vector<double> c(n + 1);
+    for (int k = 0; k <= n; k++) c[k] = v[k].real() / n;
+    c[0] *= 0.5;
+    c[n] *= 0.5;
+    return c;
+}
+
+// 批量 Clenshaw：每次取 CHEBYSHEV_BLOCK 个点，系数循环在外、点循环在内，内层跨点向量化；
+// 单点求值用 poly.hpp 的 poly_clenshaw
+inline void chebyshev_clenshaw_batch(const double *c, int degree, double lo, double hi, const double *x, double *y,
+                                     int n) {
+    double scale = 2.0 / (hi - lo), shift = -(lo + hi) / (hi - lo);
+    int blocks = (n + CHEBYSHEV_BLOCK - 1) / CHEBYSHEV_BLOCK;
+    #pragma omp parallel for schedule(static) if (n >= CHEBYSHEV_PARALLEL_MIN)
+    for (int blk = 0; blk < blocks; blk++) {
+        int start = blk * CHEBYSHEV_BLOCK;
+        int count = n - start < CHEBYSHEV_BLOCK ? n - start : CHEBYSHEV_BLOCK;
+        double t[CHEBYSHEV_BLOCK], b1[CHEBYSHEV_BLOCK], b2[CHEBYSHEV_BLOCK];
+        for (int i = 0; i < CHEBYSHEV_BLOCK; i++) {
+            t[i] = i < count ? x[start + i] * scale + shift : 0.0;
+            b1[i] = 0.0;
+            b2[i] = 0.0;
+        }
+        for (int k = degree; k >= 1; k--) {
+            double ck = c[k];
+            #pragma omp simd
+            for (int i = 0; i < CHEBYSHEV_BLOCK; i++) {
+                double b = 2.0 * t[i] * b1[i] - b2[i] + ck;
+                b2[i] = b1[i];
+                b1[i] = b;
+            }
+        }
+        for (int i = 0; i < count; i++) y[start + i] = t[i] * b1[i] - b2[i] + c[0];
+    }
+}
+
+inline double ChebyshevSeries::operator()(double x) const {
+    return poly_clenshaw(coef.data(), degree(), (2.0 * x - lo - hi) / (hi - lo));
+}
+
+inline void ChebyshevSeries::eval(const double *x, double *y, int n) const {
+    chebyshev_clenshaw_batch(coef.data(), degree(), lo, hi, x, y, n);
+}
+
+// 截断到 degree 次；对光滑函数，从足够多点的插值截断得到的系数与最佳平方逼近的系数只差混叠误差
+inline ChebyshevSeries ChebyshevSeries::truncated(int degree) const {
+    ChebyshevSeries s = *this;
+    if (degree >= 0 && degree < this->degree()) s.coef.resize(degree + 1);
+    return s;
+}
+
+// 固定 n（2 的幂）的插值：n + 1 个采样点，得到 n 次多项式
+template <class F>
+ChebyshevSeries chebyshev_interpolate(F f, double lo, double hi, int n) {
+    ChebyshevSeries s;
+    s.lo = lo;
+    s.hi = hi;
+    if (!chebyshev_detail::power_of_two(n) || !(hi > lo)) return s;
+    std::vector<double> values(n + 1);
+    #pragma omp parallel for schedule(static) if (n >= CHEBYSHEV_PARALLEL_MIN)
+    for (int j = 0; j <= n; j++) {
+        values[j] = f(0.5 * (lo + hi) + 0.5 * (hi - lo) * std::cos(M_PI * j / n));
+    }
+    s.coef = chebyshev_coefficients(values.data(), n);
+    s.evaluations = n + 1;
+    s.status = 0;
+    return s;
+}
+
+// 自适应逼近：n 从 CHEBYSHEV_MIN_POINTS 起逐次翻倍（复用已有函数值），直到系数尾部降到容限以下
+template <class F>
+ChebyshevSeries chebyshev_fit(F f, double lo, double hi, const ChebyshevOptions &opt = ChebyshevOptions()) {
+    ChebyshevSeries s;
+    s.lo = lo;
+    s.hi = hi;
+    if (!(hi > lo) || !chebyshev_detail::power_of_two(opt.max_points)) return s;
+    double mid = 0.5 * (lo + hi), half = 0.5 * (hi - lo);
+    int n = CHEBYSHEV_MIN_POINTS < opt.max_points ? CHEBYSHEV_MIN_POINTS : opt.max_points;
+    std::vector<double> values(n + 1), next;
+    #pragma omp parallel for schedule(static) if (n >= CHEBYSHEV_PARALLEL_MIN)
+    for (int j = 0; j <= n; j++) values[j] = f(mid + half * std::cos(M_PI * j / n));
+    s.evaluations = n + 1;
+    for (;;) {
+        std::vector<double> c = chebyshev_coefficients(values.data(), n);
+        int keep = chebyshev_detail::chop(c, opt.tol);
+        if (keep >= 0 || 2 * n > opt.max_points) {
+            s.status = keep >= 0 ? 0 : 1;
+            if (keep >= 0) c.resize(keep + 1);
+            s.coef.swap(c);
+            return s;
+        }
+        // 加密：偶数号点沿用旧值，只计算奇数号的新点
+        next.assign(2 * n + 1, 0.0);
+        for (int j = 0; j <= n; j++) next[2 * j] = values[j];
+        #pragma omp parallel for schedule(static) if (n >= CHEBYSHEV_PARALLEL_MIN)
+        for (int j = 1; j < 2 * n; j += 2) next[j] = f(mid + half * std::cos(M_PI * j / (2 * n)));
+        s.evaluations += n;
+        values.swap(next);
+        n *= 2;
+    }
+}
+
+#endif // CHEBYSHEV_HPP
@@ -0,0 +1,109 @@
+/***
+ * 切比雪夫逼近：DCT 一次求全部系数与逐个系数做自适应积分的比较，自适应次数选择，批量 Clenshaw 代替昂贵函数
+ * @Date 2026/10/19
+ * @Author: 王春博
+ */
+#include <cstdio>
+#include <cmath>
+#include <vector>
+#include "chebyshev.hpp"
+#include "../common/bench.h"
+#include "../common/rng.h"
+
+#define PROJECTION_POINTS 65536  // 用插值截断近似最佳平方逼近时的采样点数
+#define TIMING_DEGREE 1024       // 计时比较时求的系数个数
+#define SURROGATE_POINTS 200000  // 代用函数的求值点数
+
+// 作业中的目标函数
+double f(double x) {
+    return std::sqrt(1 - x * x);
+}
+
+// 自适应辛卜生
+template <class G>
+double adaptive_simpson(G &g, double a, double b, double fa, double fm, double fb, double whole, double eps, int depth) {
+    double m = 0.5 * (a + b), lm = 0.5 * (a + m), rm = 0.5 * (m + b);
+    double flm = g(lm), frm = g(rm);
+    double left = (m - a) / 6 * (fa + 4 * flm + fm), right = (b - m) / 6 * (fm + 4 * frm + fb);
+    if (depth <= 0 || std::fabs(left + right - whole) <= 15 * eps) return left + right + (left + right - whole) / 15;
+    return adaptive_simpson(g, a, m, fa, flm, fm, left, 0.5 * eps, depth - 1) +
+           adaptive_simpson(g, m, b, fm, frm, fb, right, 0.5 * eps, depth - 1);
+}
+
+// 与 main.py 相同的做法：c_k = (2/π) ∫ f(x) T_k(x) / sqrt(1 - x^2) dx，换元 x = cosθ 后逐个积分；
+// 被积函数有 k 个振荡，先分成 k + 1 段再各自自适应，否则起步的三个点可能恰好落在零点上
+double quad_coefficient(double (*func)(double), int k, double eps) {
+    auto g = [&](double theta) { return func(std::cos(theta)) * std::cos(k * theta); };
+    double value = 0.0, h = M_PI / (k + 1);
+    for (int p = 0; p <= k; p++) {
+        double a = p * h, b = a + h;
+        double fa = g(a), fm = g(a + 0.5 * h), fb = g(b);
+        value += adaptive_simpson(g, a, b, fa, fm, fb, h / 6 * (fa + 4 * fm + fb), eps / (k + 1), 50);
+    }
+    return (k == 0 ? 1.0 : 2.0) * value / M_PI;
+}
+
+// 代用函数的例子：J0(x) = (1/π) ∫_0^π cos(x sinθ) dθ，每次求值做 256 点中点积分
+double bessel_j0(double x) {
+    const int m = 256;
+    double sum = 0.0;
+    for (int i = 0; i < m; i++) sum += std::cos(x * std::sin(M_PI * (i + 0.5) / m));
+    return sum / m;
+}
+
+double rms_error(const ChebyshevSeries &s) {
+    double sum = 0.0;
+    for (int i = 0; i < 500; i++) {
+        double x = -1.0 + 2.0 * i / 499;
+        sum += (f(x) - s(x)) * (f(x) - s(x));
+    }
+    return std::sqrt(sum / 500);
+}
+
+int main() {
+    // 作业：8 次与 10 次最佳平方逼近
+    ChebyshevSeries fine = chebyshev_interpolate(f, -1, 1, PROJECTION_POINTS);
+    for (int degree : {8, 10}) {
+        ChebyshevSeries s = fine.truncated(degree);
+        double diff = 0.0;
+        for (int k = 0; k <= degree; k++) diff = std::fmax(diff, std::fabs(s.coef[k] - quad_coefficient(f, k, 1e-12)));
+        printf("%d次逼近误差: %.10f（与逐个积分的系数最大差 %.2e）\n", degree, rms_error(s), diff);
+    }
+
+    // 求 TIMING_DEGREE + 1 个系数：逐个积分 vs 一次 DCT
+    double t0 = bench_now();
+    std::vector<double> quad(TIMING_DEGREE + 1);
+    for (int k = 0; k <= TIMING_DEGREE; k++) quad[k] = quad_coefficient(f, k, 1e-10);
+    double t1 = bench_now();
+    ChebyshevSeries dct = chebyshev_interpolate(f, -1, 1, PROJECTION_POINTS).truncated(TIMING_DEGREE);
+    double t2 = bench_now();
+    double diff = 0.0;
+    for (int k = 0; k <= TIMING_DEGREE; k++) diff = std::fmax(diff, std::fabs(dct.coef[k] - quad[k]));
+    printf("%d 个系数: 逐个积分 %.3f s，DCT（%d 点）%.4f s，系数最大差 %.2e\n", TIMING_DEGREE + 1, t1 - t0,
+           PROJECTION_POINTS + 1, t2 - t1, diff);
+
+    // 自适应次数：光滑函数很快收敛，端点有奇性的作业函数到上限仍未收敛
+    ChebyshevSeries smooth = chebyshev_fit([](double x) { return std::exp(std::sin(5 * x)); }, -1, 1);
+    ChebyshevSeries rough = chebyshev_fit(f, -1, 1);
+    printf("exp(sin 5x): %d 次，%ld 次求值，状态 %d；sqrt(1 - x^2): %d 次，%ld 次求值，状态 %d\n", smooth.degree(),
+           smooth.evaluations, smooth.status, rough.degree(), rough.evaluations, rough.status);
+
+    // 代用函数：[0, 50] 上的 J0
+    t0 = bench_now();
+    ChebyshevSeries j0 = chebyshev_fit(bessel_j0, 0, 50);
+    t1 = bench_now();
+    std::vector<double> x(SURROGATE_POINTS), exact(SURROGATE_POINTS), approx(SURROGATE_POINTS);
+    Rng rng;
+    rng_init(&rng, 20261019);
+    for (int i = 0; i < SURROGATE_POINTS; i++) x[i] = rng_uniform_range(&rng, 0, 50);
+    t2 = bench_now();
+    for (int i = 0; i < SURROGATE_POINTS; i++) exact[i] = bessel_j0(x[i]);
+    double t3 = bench_now();
+    j0.eval(x.data(), approx.data(), SURROGATE_POINTS);
+    double t4 = bench_now();
+    double err = 0.0;
+    for (int i = 0; i < SURROGATE_POINTS; i++) err = std::fmax(err, std::fabs(exact[i] - approx[i]));
+    printf("J0 代用函数: %d 次（构造 %.2f ms，%ld 次求值）；%d 点直接求值 %.3f s，Clenshaw %.4f s，最大误差 %.2e\n",
+           j0.degree(), (t1 - t0) * 1e3, j0.evaluations, SURROGATE_POINTS, t3 - t2, t4 - t3, err);
+    return 0;
+}
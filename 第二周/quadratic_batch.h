@@ -0,0 +1,102 @@
+/**
+ * Author: 王春博
+ * Date: 2026.10.19
+ * Description: 数值计算与算法：批量求解一元二次方程 a x^2 + b x + c = 0
+ *
+ * 使用无抵消公式 q = -(b + sign(b) sqrt(Δ)) / 2，x1 = q / a，x2 = c / q；
+ * 系数量级超出安全范围时才按 2 的整数次幂缩放（不引入舍入误差）。
+ * 热路径上没有分支和 I/O，全部用条件选择表达，便于编译器向量化。
+ * 需配合 -fno-math-errno -fno-trapping-math 编译才能真正向量化。
+ */
+
+#ifndef QUADRATIC_BATCH_H
+#define QUADRATIC_BATCH_H
+
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+// 求解状态
+#define QUAD_REAL 0        // 两个实根，x1 <= x2
+#define QUAD_COMPLEX 1     // 一对共轭复根，x1 为实部，x2 为虚部（非负）
+#define QUAD_LINEAR 2      // a = 0，退化为一次方程，x1 = x2 = -c / b
+#define QUAD_DEGENERATE 3  // a = b = 0，无有效根，x1 = x2 = NaN
+#define QUAD_NONFINITE 4   // 系数含 Inf 或 NaN，x1 = x2 = NaN
+
+#define QUAD_SAFE_EXP 500  // 最大系数的二进制指数超过 ±500 时才缩放
+
+// 构造 2^e（e 在正规数范围内）
+static inline double quad_pow2(int64_t e) {
+    uint64_t bits = (uint64_t) (e + 1023) << 52;
+    double r;
+    memcpy(&r, &bits, sizeof(r));
+    return r;
+}
+
+// 取正规数 x 的二进制指数（非正规数与 0 视为 -1023，Inf 与 NaN 为 1024）
+static inline int64_t quad_exponent(double x) {
+    uint64_t bits;
+    memcpy(&bits, &x, sizeof(bits));
+    return (int64_t) ((bits >> 52) & 0x7FF) - 1023;
+}
+
+// 判别式 b^2 - 4ac；有硬件 FMA 时用无误差变换消除 b^2 与 4ac 相近时的抵消
+static inline double quad_discriminant(double a, double b, double c) {
+#ifdef __FMA__
+    double p = b * b;
+    double dp = fma(b, b, -p);
+    double q = 4 * a * c;
+    double dq = fma(4 * a, c, -q);
+    return (p - q) + (dp - dq);
+#else
+    return b * b - 4 * a * c;
+#endif
+}
+
+// 单个方程，供批量循环内联
+static inline void quadratic_solve_one(double a, double b, double c, double *x1, double *x2, int *status) {
+    // 非有限系数下缩放指数与各公式都无意义，结果整体改为 NaN
+    int is_nonfinite = !(isfinite(a) & isfinite(b) & isfinite(c));
+    int is_linear = a == 0.0;
+    int is_degenerate = is_linear & (b == 0.0);
+
+    // 仅在需要时缩放：根不随系数同乘一个常数而改变
+    double m = fabs(a) > fabs(b) ? fabs(a) : fabs(b);
+    m = m > fabs(c) ? m : fabs(c);
+    int64_t e = quad_exponent(m);
+    int64_t need = (e > QUAD_SAFE_EXP) | (e < -QUAD_SAFE_EXP);
+    double s = quad_pow2(need ? -e : 0);
+    a *= s;
+    b *= s;
+    c *= s;
+
+    double disc = quad_discriminant(a, b, c);
+    double root = sqrt(fabs(disc));
+    double q = -0.5 * (b + copysign(root, b));
+    double r1 = q / a;
+    double r2 = q != 0.0 ? c / q : 0.0;
+    double lo = r1 < r2 ? r1 : r2;
+    double hi = r1 < r2 ? r2 : r1;
+    double re = -b / (2 * a);
+    double im = root / (2 * fabs(a));
+    double lin = -c / b;
+
+    int is_complex = disc < 0.0;
+    int no_root = is_nonfinite | is_degenerate;
+    *x1 = no_root ? NAN : (is_linear ? lin : (is_complex ? re : lo));
+    *x2 = no_root ? NAN : (is_linear ? lin : (is_complex ? im : hi));
+    *status = is_nonfinite ? QUAD_NONFINITE
+                           : (is_degenerate ? QUAD_DEGENERATE
+                                            : (is_linear ? QUAD_LINEAR : (is_complex ? QUAD_COMPLEX : QUAD_REAL)));
+}
+
+// 批量求解 n 个方程，系数与结果均为结构数组
+static inline void quadratic_solve_batch(const double *a, const double *b, const double *c, int n,
+                                         double *x1, double *x2, int *status) {
+    #pragma omp parallel for simd schedule(static)
+    for (int i = 0; i < n; i++) {
+        quadratic_solve_one(a[i], b[i], c[i], &x1[i], &x2[i], &status[i]);
+    }
+}
+
+#endif // QUADRATIC_BATCH_H
@@ -8,6 +8,8 @@
 #include <stdio.h>
 #include <math.h>
 #include <float.h>
+#include "../common/roots.hpp"
+#include "../common/poly.hpp"
 
 #define LARGE_THRESHOLD 1e150
 #define SMALL_THRESHOLD 1e-150
@@ -59,32 +61,31 @@ void solve_optimized(double a, double b, double c) {
     printf("Optimized roots: x1 = %.10e, x2 = %.10e\n", x1, x2);
 }
 
-// 使用牛顿迭代法
-void solve_newton(double a, double b, double c, double initial_guess) {
-    double x = initial_guess;
-    int max_iterations = 10000;
-    double tolerance = 1e-12;
-
-    for (int i = 0; i < max_iterations; ++i) {
-        double fx = a * x * x + b * x + c;
-        double fpx = 2 * a * x + b;
-
-        if (fabs(fpx) < DBL_EPSILON) {
-            printf("Derivative near zero; Newton method fails.\n");
-            return;
-        }
-
-        double x_new = x - fx / fpx;
-
-        if (fabs(x_new - x) < tolerance) {
-            printf("Newton root: x = %.10e\n", x_new);
-            return;
-        }
-
-        x = x_new;
+// 二次多项式及其导数，供通用求根引擎使用；一趟 Horner 同时得到值与导数
+struct QuadraticFunction {
+    double a, b, c;
+    void eval(double x, double &f, double &df) const {
+        const double coef[3] = {c, b, a};
+        f = poly_horner_deriv<2>(coef, x, df);
     }
+};
 
-    printf("Failed to converge after %d iterations.\n", max_iterations);
+// 使用牛顿迭代法：先从初始猜测扩张出变号区间，再做带保护的牛顿迭代
+void solve_newton(double a, double b, double c, double initial_guess) {
+    QuadraticFunction f = {a, b, c};
+    RootOptions opt;
+    opt.x_tol = 1e-12;
+    RootResult r = find_root_from_guess(f, initial_guess, opt);
+
+    if (r.status == ROOT_ZERO_DERIVATIVE) {
+        printf("Derivative is zero at x = %.10e; Newton method fails.\n", r.x);
+    } else if (r.status == ROOT_NO_BRACKET) {
+        printf("No sign change found around the initial guess; Newton method fails.\n");
+    } else if (r.status == ROOT_MAX_ITER) {
+        printf("Failed to converge after %d iterations.\n", r.iterations);
+    } else {
+        printf("Newton root: x = %.10e (%d iterations)\n", r.x, r.iterations);
+    }
 }
 
 // 主函数，判断使用哪种方法求解
@@ -0,0 +1,112 @@
+/**
+ * Author: 王春博
+ * Date: 2026.10.19
+ * Description: 多项式求值：pow 逐项求和、运行时次数的 Horner 与编译期展开的 Horner / Estrin / Clenshaw / de Casteljau 的吞吐量比较
+ */
+
+#include <stdio.h>
+#include <math.h>
+#include <vector>
+#include "../common/poly.hpp"
+#include "../common/bench.h"
+#include "../common/rng.h"
+
+#define POINTS (1 << 22)  // 求值点数
+#define REPEAT 5          // 计时重复次数
+
+// 逐项 pow 求和，与原先的写法相同
+void eval_pow(const double *c, int degree, const double *x, double *y, long n) {
+    for (long i = 0; i < n; i++) {
+        double s = 0.0;
+        for (int k = 0; k <= degree; k++) s += c[k] * pow(x[i], k);
+        y[i] = s;
+    }
+}
+
+// 贝塞尔曲线一维分量的原写法：二项式系数 * pow(1 - t, n - k) * pow(t, k)
+void eval_bernstein_pow(const double *c, int degree, const double *x, double *y, long n) {
+    for (long i = 0; i < n; i++) {
+        double s = 0.0, binom = 1.0;
+        for (int k = 0; k <= degree; k++) {
+            s += binom * pow(1 - x[i], degree - k) * pow(x[i], k) * c[k];
+            binom = binom * (degree - k) / (k + 1);
+        }
+        y[i] = s;
+    }
+}
+
+void eval_runtime_horner(const double *c, int degree, const double *x, double *y, long n) {
+    #pragma omp parallel for schedule(static)
+    for (long i = 0; i < n; i++) y[i] = poly_horner(c, degree, x[i]);
+}
+
+template <class Fn>
+double time_it(Fn fn) {
+    double best = 1e300;
+    for (int r = 0; r < REPEAT; r++) {
+        double t0 = bench_now();
+        fn();
+        best = fmin(best, bench_now() - t0);
+    }
+    return best;
+}
+
+double max_diff(const std::vector<double> &a, const std::vector<double> &b) {
+    double d = 0.0;
+    for (size_t i = 0; i < a.size(); i++) d = fmax(d, fabs(a[i] - b[i]) / (1.0 + fabs(b[i])));
+    return d;
+}
+
+void report(const char *name, double seconds, double base, double err) {
+    printf("  %8.2f ms  %7.1f M点/秒  加速 x%-6.1f 相对差 %.2e  %s\n", seconds * 1e3, POINTS / seconds * 1e-6,
+           base / seconds, err, name);
+}
+
+template <int N>
+void compare(const std::vector<double> &x) {
+    double c[N + 1];
+    Rng rng;
+    rng_init(&rng, 20261019 + N);
+    for (int k = 0; k <= N; k++) c[k] = rng_uniform_range(&rng, -1, 1);
+    std::vector<double> ref(POINTS), y(POINTS), dy(POINTS);
+    printf("%d 次多项式，%d 个点：\n", N, POINTS);
+
+    double base = time_it([&] { eval_pow(c, N, x.data(), ref.data(), POINTS); });
+    report("pow 逐项求和", base, base, 0.0);
+    double t = time_it([&] { eval_runtime_horner(c, N, x.data(), y.data(), POINTS); });
+    report("Horner（运行时次数）", t, base, max_diff(y, ref));
+    t = time_it([&] { poly_eval_batch<PolyScheme::Horner, N>(c, x.data(), y.data(), POINTS); });
+    report("Horner（编译期展开）", t, base, max_diff(y, ref));
+    t = time_it([&] { poly_eval_batch<PolyScheme::Estrin, N>(c, x.data(), y.data(), POINTS); });
+    report("Estrin", t, base, max_diff(y, ref));
+    t = time_it([&] { poly_horner_deriv_batch<N>(c, x.data(), y.data(), dy.data(), POINTS); });
+    report("Horner 值 + 导数", t, base, max_diff(y, ref));
+
+    // 切比雪夫级数：与 pow 写法比较同一多项式 Σ c_k T_k(x)，T_k 用 cos(k arccos x)
+    t = time_it([&] { poly_eval_batch<PolyScheme::Clenshaw, N>(c, x.data(), y.data(), POINTS); });
+    for (long i = 0; i < POINTS; i++) {
+        double s = 0.0;
+        for (int k = 0; k <= N; k++) s += c[k] * cos(k * acos(x[i]));
+        ref[i] = s;
+    }
+    report("Clenshaw（切比雪夫级数）", t, base, max_diff(y, ref));
+
+    // 伯恩斯坦基：x 映射到 [0, 1]
+    std::vector<double> u(POINTS);
+    for (long i = 0; i < POINTS; i++) u[i] = 0.5 * (x[i] + 1);
+    double bp = time_it([&] { eval_bernstein_pow(c, N, u.data(), ref.data(), POINTS); });
+    t = time_it([&] { poly_eval_batch<PolyScheme::Bernstein, N>(c, u.data(), y.data(), POINTS); });
+    printf("  伯恩斯坦基：pow 写法 %.2f ms，de Casteljau %.2f ms（加速 x%.1f），相对差 %.2e\n", bp * 1e3, t * 1e3, bp / t,
+           max_diff(y, ref));
+}
+
+int main() {
+    std::vector<double> x(POINTS);
+    Rng rng;
+    rng_init(&rng, 20261019);
+    for (long i = 0; i < POINTS; i++) x[i] = rng_uniform_range(&rng, -1, 1);
+    compare<3>(x);
+    compare<7>(x);
+    compare<15>(x);
+    return 0;
+}
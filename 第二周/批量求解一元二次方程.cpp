@@ -0,0 +1,67 @@
+/**
+ * Author: 王春博
+ * Date: 2026.10.19
+ * Description: 数值计算与算法：批量求解一元二次方程，正确性检查与吞吐量测试
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <chrono>
+#include <vector>
+#include "quadratic_batch.h"
+#include "../common/rng.h"
+
+#define CHUNK (1 << 20)           // 每批方程个数
+#define DEFAULT_TOTAL 100000000L  // 默认测试 10^8 组系数
+
+static const char *status_name[] = {"real", "complex", "linear", "degenerate", "nonfinite"};
+
+int main(int argc, char *argv[]) {
+    // 与一元二次方程求解.cpp 相同的测试数据，外加复根、完全退化与非有限系数的情形
+    double a[10] = {6e154, 0, 1, 1, 1e-154, 1, 1, 0, INFINITY, 1};
+    double b[10] = {4e154, 2, -1e6, -(1e8 + 1e-8), -1e155, -5, 2, 0, 1, NAN};
+    double c[10] = {-5e154, 2, 1, 1.5, 1e155, 4.999999, 5, 1, 1, 1};
+    double x1[10], x2[10];
+    int status[10];
+    quadratic_solve_batch(a, b, c, 10, x1, x2, status);
+    for (int i = 0; i < 10; i++) {
+        printf("a = %.10e, b = %.10e, c = %.10e -> %-10s x1 = %.10e, x2 = %.10e\n",
+               a[i], b[i], c[i], status_name[status[i]], x1[i], x2[i]);
+    }
+
+    // 吞吐量：分批生成随机系数并求解，只统计求解时间
+    long total = argc > 1 ? atol(argv[1]) : DEFAULT_TOTAL;
+    std::vector<double> va(CHUNK), vb(CHUNK), vc(CHUNK), r1(CHUNK), r2(CHUNK);
+    std::vector<int> st(CHUNK);
+    rng_fill_uniform_parallel(1, va.data(), CHUNK, -10, 10);
+    rng_fill_uniform_parallel(2, vb.data(), CHUNK, -10, 10);
+    rng_fill_uniform_parallel(3, vc.data(), CHUNK, -10, 10);
+
+    double seconds = 0.0, max_residual = 0.0;
+    long counts[5] = {0, 0, 0, 0, 0};
+    for (long done = 0; done < total; done += CHUNK) {
+        int n = (int) (total - done < CHUNK ? total - done : CHUNK);
+        auto start = std::chrono::steady_clock::now();
+        quadratic_solve_batch(va.data(), vb.data(), vc.data(), n, r1.data(), r2.data(), st.data());
+        auto end = std::chrono::steady_clock::now();
+        seconds += std::chrono::duration<double>(end - start).count();
+
+        // 只检查第一批：实根代回方程的相对残差
+        if (done == 0) {
+            for (int i = 0; i < n; i++) {
+                counts[st[i]]++;
+                if (st[i] != QUAD_REAL) continue;
+                double roots[2] = {r1[i], r2[i]};
+                for (int k = 0; k < 2; k++) {
+                    double x = roots[k];
+                    double scale = fabs(va[i] * x * x) + fabs(vb[i] * x) + fabs(vc[i]);
+                    max_residual = fmax(max_residual, fabs((va[i] * x + vb[i]) * x + vc[i]) / scale);
+                }
+            }
+        }
+    }
+    printf("第一批: 实根 %ld 组, 复根 %ld 组, 最大相对残差 %.3e\n", counts[QUAD_REAL], counts[QUAD_COMPLEX], max_residual);
+    printf("%ld 组系数, 求解时间 %.4f 秒, %.3e 根/秒\n", total, seconds, 2.0 * total / seconds);
+    return 0;
+}
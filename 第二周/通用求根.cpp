@@ -0,0 +1,93 @@
+/**
+ * Author: 王春博
+ * Date: 2026.10.19
+ * Description: 数值计算与算法：通用求根引擎的使用示例与批量开普勒方程求解
+ */
+
+#include <stdio.h>
+#include <math.h>
+#include <chrono>
+#include <vector>
+#include "../common/roots.hpp"
+#include "../common/rng.h"
+#include "../common/trace.h"
+
+// f(x) = x^3 - 2x - 5，只给函数值
+struct CubicValue {
+    double operator()(double x) const { return (x * x - 2) * x - 5; }
+};
+
+// 同一函数，给出一阶导数
+struct CubicNewton {
+    void eval(double x, double &f, double &df) const {
+        f = (x * x - 2) * x - 5;
+        df = 3 * x * x - 2;
+    }
+};
+
+// 同一函数，给出一、二阶导数
+struct CubicHalley {
+    void eval(double x, double &f, double &df, double &d2f) const {
+        f = (x * x - 2) * x - 5;
+        df = 3 * x * x - 2;
+        d2f = 6 * x;
+    }
+};
+
+// 开普勒方程 E - e sin E - M = 0
+struct Kepler {
+    double e, M;
+    void eval(double E, double &f, double &df, double &d2f) const {
+        double s = sin(E), c = cos(E);
+        f = E - e * s - M;
+        df = 1 - e * c;
+        d2f = e * s;
+    }
+};
+
+void report(const char *name, RootResult r) {
+    printf("%-8s x = %.16f, f(x) = %.3e, 迭代 %d 次, 状态 %d\n", name, r.x, r.fx, r.iterations, r.status);
+}
+
+int main() {
+    CubicValue fv;
+    CubicNewton fn;
+    CubicHalley fh;
+    // 启用 NUMERIC_TRACE 时，单个方程的迭代过程写到 roots_trace.csv（批量部分不记录）
+    TraceSession trace;
+    trace_session_begin(&trace, "roots_trace.csv", TRACE_CSV);
+    report("Brent", find_root(fv, 2, 3, 2.5));
+    report("Newton", find_root(fn, 2, 3, 2.5));
+    report("Halley", find_root(fh, 2, 3, 2.5));
+    report("Guess", find_root_from_guess(fn, -10.0));
+    if (trace.active) printf("收敛轨迹: %ld 条写入 roots_trace.csv\n", trace_session_end(&trace));
+
+    // 批量：10^6 个开普勒方程，E 一定落在 [M - e, M + e] 内
+    const int n = 1000000;
+    std::vector<double> ecc(n), mean(n), lo(n), hi(n);
+    Rng rng;
+    rng_init(&rng, 1609);
+    for (int i = 0; i < n; i++) {
+        ecc[i] = rng_uniform_range(&rng, 0, 0.99);
+        mean[i] = rng_uniform_range(&rng, 0, 2 * M_PI);
+        lo[i] = mean[i] - ecc[i];
+        hi[i] = mean[i] + ecc[i];
+    }
+    std::vector<RootResult> out(n);
+    auto start = std::chrono::steady_clock::now();
+    find_roots_batch([&](int i) { return Kepler{ecc[i], mean[i]}; }, n, lo.data(), hi.data(), mean.data(), out.data());
+    auto end = std::chrono::steady_clock::now();
+
+    long total_iter = 0;
+    int max_iter = 0, failed = 0;
+    double max_residual = 0.0;
+    for (int i = 0; i < n; i++) {
+        total_iter += out[i].iterations;
+        if (out[i].iterations > max_iter) max_iter = out[i].iterations;
+        if (out[i].status != ROOT_CONVERGED) failed++;
+        max_residual = fmax(max_residual, fabs(out[i].fx));
+    }
+    printf("开普勒方程 %d 个: %.4f 秒, 平均迭代 %.2f 次, 最多 %d 次, 未收敛 %d 个, 最大残差 %.3e\n",
+           n, std::chrono::duration<double>(end - start).count(), (double) total_iter / n, max_iter, failed, max_residual);
+    return 0;
+}
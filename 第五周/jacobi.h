@@ -0,0 +1,46 @@
+/**
+ * @Descripttion: 稠密矩阵的雅克比迭代，矩阵按行指针存放（可直接传 Matrix.row）
+ * @filename: jacobi.h
+ * @Author: 王春博
+ * @Date: 2026.10.19
+ * @Version: V1.0
+ *
+ * 每次迭代对每一行跳过对角元、分左右两段做补偿点积；收敛判据为 ||x_new - x||_1 <= tol。
+ * 不分配内存：x_new 由调用方提供（可取自 Arena）。C 与 C++ 均可直接包含。
+ */
+
+#ifndef JACOBI_H
+#define JACOBI_H
+
+#include <math.h>
+#include "../common/sum.h"
+#include "../common/trace.h"
+
+// 从 x 出发迭代，x 就地更新为最后一次迭代的结果；返回迭代次数，达到 max_iter 仍未收敛时返回 max_iter
+static inline int jacobi_iterate(double *const *A, const double *b, double *x, double *x_new, int n, double tol,
+                                 int max_iter) {
+    int iter = 0;
+    double error;
+
+    do {
+        error = 0.0;
+        for (int i = 0; i < n; i++) {
+            // 跳过对角元：分别对左右两段做补偿点积
+            double sum = sum_dot(A[i], x, i) + sum_dot(A[i] + i + 1, x + i + 1, n - i - 1);
+            x_new[i] = (b[i] - sum) / A[i][i];
+            error += fabs(x_new[i] - x[i]);
+        }
+
+        // 更新x
+        for (int i = 0; i < n; i++) {
+            x[i] = x_new[i];
+        }
+
+        iter++;
+        TRACE(TRACE_JACOBI, iter, error, error);  // 雅克比迭代的步长即 D^-1 (b - A x)
+    } while (error > tol && iter < max_iter);
+
+    return iter;
+}
+
+#endif // JACOBI_H
@@ -0,0 +1,157 @@
+/**
+ * @Descripttion: 结构检测 + 带状/三对角/三角快速求解，与稠密存储的规模对比
+ * @filename: 带状矩阵快速求解.c
+ * @Author: 王春博
+ * @Date: 2026.10.19
+ * @Version: V1.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "../common/rng.h"
+#include "../common/sum.h"
+#include "../common/banded.h"
+#include "../common/bench.h"
+#include "../common/matrix.h"
+#include "../common/test_matrix.h"
+
+#define N 1000     // 稠密存储测试的矩阵阶数
+#define BIG_N 1000000  // 紧凑存储测试的矩阵阶数，稠密存储需要 8TB
+#define SPARSITY 0.05  // 稀疏度，表示非零元素占总元素的比例
+#define SEED 20241015  // 随机数种子，保证生成的测试矩阵可复现
+
+// 函数：生成下带宽 kl、上带宽 ku 的随机带状矩阵；对角元稍大以保证良态，但不占优，求解时需要选主元
+void generate_banded_matrix(double **A, double *b, int kl, int ku) {
+    Rng rng;
+    rng_init(&rng, SEED + 1);
+    for (int i = 0; i < N; i++) {
+        b[i] = rng_uniform_range(&rng, -1, 1);
+        for (int j = 0; j < N; j++) {
+            A[i][j] = (j >= i - kl && j <= i + ku) ? rng_uniform_range(&rng, -1, 1) : 0.0;
+        }
+        A[i][i] += A[i][i] >= 0 ? 1.0 : -1.0;
+    }
+}
+
+// 函数：评估准确性
+double evaluate_accuracy(double *x, double *b, double **A) {
+    SumAcc error_sum = sum_acc_init();
+    for (int i = 0; i < N; i++) {
+        sum_acc_add(&error_sum, fabs(b[i] - sum_dot(A[i], x, N)));
+    }
+    return sum_acc_result(error_sum);
+}
+
+void solve_and_report(const char *title, double **A, double *b, double *x) {
+    int structure;
+    double start_time = bench_now();
+    int info = structured_solve(A, N, b, x, &structure);
+    double elapsed_time = bench_now() - start_time;
+    if (info != 0) {
+        printf("%s: 检测为%s，未求解（返回 %d）\n", title, matrix_structure_name(structure), info);
+        return;
+    }
+    printf("%s: 检测为%s，求解时间 %f 秒，误差总和 %e\n", title, matrix_structure_name(structure),
+           elapsed_time, evaluate_accuracy(x, b, A));
+}
+
+int main() {
+    Matrix a;
+    int ok = matrix_alloc(&a, N, N) == 0;
+    double *b = vector_alloc(N);
+    double *x = vector_alloc(N);
+    if (!ok || b == NULL || x == NULL) {
+        printf("内存分配失败\n");
+        return -1;
+    }
+    double **A = a.row;
+
+    // 第五周的稀疏上三角矩阵：跳过消元，直接回代
+    generate_sparse_upper_triangular_matrix(A, b, N, SPARSITY, SEED);
+    solve_and_report("稀疏上三角", A, b, x);
+
+    // 带状与三对角：带状 LU / 追赶法
+    generate_banded_matrix(A, b, 3, 5);
+    solve_and_report("带状 kl=3 ku=5", A, b, x);
+    generate_banded_matrix(A, b, 1, 1);
+    solve_and_report("三对角（不占优）", A, b, x);
+    for (int i = 0; i < N; i++) {
+        A[i][i] = 4.0;
+    }
+    solve_and_report("三对角（占优）", A, b, x);
+
+    // 一般稠密矩阵交给稠密消元
+    generate_banded_matrix(A, b, N, N);
+    solve_and_report("一般稠密", A, b, x);
+
+    matrix_free(&a);
+    vector_free(b);
+    vector_free(x);
+
+    // 百万阶：直接用紧凑存储，带状 LU 与追赶法都是 O(N)
+    Rng rng;
+    rng_init(&rng, SEED);
+    BandMatrix m;
+    double *rhs = (double *)malloc(BIG_N * sizeof(double));
+    double *sol = (double *)malloc(BIG_N * sizeof(double));
+    if (rhs == NULL || sol == NULL || band_alloc(&m, BIG_N, 2, 2) != 0) {
+        printf("内存分配失败\n");
+        return -1;
+    }
+    for (int i = 0; i < BIG_N; i++) {
+        for (int j = i - 2; j <= i + 2; j++) {
+            if (j >= 0 && j < BIG_N) {
+                *band_at(&m, i, j) = rng_uniform_range(&rng, -1, 1);
+            }
+        }
+        *band_at(&m, i, i) += 2.0;
+    }
+    // 用已知解构造右端项：sol = A * ones，求解后应恢复为全 1
+    for (int i = 0; i < BIG_N; i++) {
+        double s = 0.0;
+        for (int j = i - 2; j <= i + 2; j++) {
+            if (j >= 0 && j < BIG_N) {
+                s += *band_at(&m, i, j);
+            }
+        }
+        sol[i] = s;
+    }
+    double start_time = bench_now();
+    int info = band_lu_factor(&m);
+    if (info == 0) {
+        band_lu_solve(&m, sol);
+    }
+    double elapsed_time = bench_now() - start_time;
+    double max_err = 0.0;
+    for (int i = 0; i < BIG_N; i++) {
+        max_err = fmax(max_err, fabs(sol[i] - 1.0));
+    }
+    printf("带状 LU N=%d kl=ku=2: 时间 %f 秒，与精确解的最大误差 %e\n", BIG_N, elapsed_time, max_err);
+    band_free(&m);
+
+    double *sub = (double *)malloc(BIG_N * sizeof(double));
+    double *diag = (double *)malloc(BIG_N * sizeof(double));
+    double *sup = (double *)malloc(BIG_N * sizeof(double));
+    for (int i = 0; i < BIG_N; i++) {
+        sub[i] = i > 0 ? -1.0 : 0.0;
+        sup[i] = i < BIG_N - 1 ? -1.0 : 0.0;
+        diag[i] = 2.5;
+        rhs[i] = diag[i] + sub[i] + sup[i];  // 精确解全为 1
+    }
+    start_time = bench_now();
+    thomas_solve(sub, diag, sup, rhs, BIG_N, sol);
+    elapsed_time = bench_now() - start_time;
+    max_err = 0.0;
+    for (int i = 0; i < BIG_N; i++) {
+        max_err = fmax(max_err, fabs(rhs[i] - 1.0));
+    }
+    printf("追赶法 N=%d: 时间 %f 秒，与精确解的最大误差 %e\n", BIG_N, elapsed_time, max_err);
+
+    free(sub);
+    free(diag);
+    free(sup);
+    free(rhs);
+    free(sol);
+    return 0;
+}
@@ -0,0 +1,187 @@
+/**
+ * @Descripttion: 三角方程组求解对比：逐行回代、CSR 层次调度并行求解、分块 SIMD 稠密回代与多右端项 TRSM
+ * @filename: 并行三角求解.c
+ * @Author: 王春博
+ * @Date: 2026.10.19
+ * @Version: V1.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#include "../common/rng.h"
+#include "../common/trisolve.h"
+#include "../common/bench.h"
+#include "../common/matrix.h"
+#include "../common/test_matrix.h"
+
+#define N 4000     // 矩阵阶数
+#define SPARSITY 0.05  // 稀疏度，表示非零元素占总元素的比例
+#define ROW_NNZ 4  // 极稀疏矩阵每行的非对角元个数
+#define NRHS 32    // 多右端项个数
+#define REPEAT 10  // 计时重复次数
+#define SEED 20241015  // 随机数种子，保证生成的测试矩阵可复现
+
+// 函数：生成每行只有 ROW_NNZ 个非对角元的上三角矩阵，依赖链短，层数少
+void generate_very_sparse_upper_triangular_matrix(double **A) {
+    Rng rng;
+    rng_init(&rng, SEED + 1);
+    for (int i = 0; i < N; i++) {
+        memset(A[i], 0, N * sizeof(double));
+        A[i][i] = rng_below(&rng, 10) + 5;
+        for (int k = 0; k < ROW_NNZ && i < N - 1; k++) {
+            A[i][i + 1 + rng_below(&rng, N - 1 - i)] = rng_uniform_range(&rng, -1, 1);
+        }
+    }
+}
+
+// 原消元程序中的逐行回代
+void back_substitution(double **A, const double *b, double *x) {
+    for (int i = N - 1; i >= 0; i--) {
+        x[i] = b[i];
+        for (int j = i + 1; j < N; j++) {
+            x[i] -= A[i][j] * x[j];
+        }
+        x[i] /= A[i][i];
+    }
+}
+
+// 相对差：max|x - y| / max|y|
+double max_diff(const double *x, const double *y, int n) {
+    double m = 0.0, scale = 0.0;
+    for (int i = 0; i < n; i++) {
+        m = fmax(m, fabs(x[i] - y[i]));
+        scale = fmax(scale, fabs(y[i]));
+    }
+    return scale > 0 ? m / scale : m;
+}
+
+// 三种单右端项求解的对比；成功返回 0，内存不足返回 -1，对角元为零时返回该行号 + 1
+int compare(const char *title, double **A, const double *b, Arena *arena) {
+    size_t mark = arena_mark(arena);
+    double *ref = arena_vector(arena, N);
+    double *x = arena_vector(arena, N);
+    if (ref == NULL || x == NULL) {
+        arena_release(arena, mark);
+        return -1;
+    }
+
+    double start = bench_now();
+    for (int r = 0; r < REPEAT; r++) {
+        back_substitution(A, b, ref);
+    }
+    double t_seq = (bench_now() - start) / REPEAT;
+
+    CsrMatrix m;
+    TriSchedule s;
+    if (csr_from_dense(&m, A, N) != 0) {
+        arena_release(arena, mark);
+        return -1;
+    }
+    start = bench_now();
+    int info = tri_schedule_build(&s, &m, 1);
+    if (info != 0) {
+        csr_free(&m);
+        arena_release(arena, mark);
+        return info;
+    }
+    double t_build = bench_now() - start;
+    start = bench_now();
+    for (int r = 0; r < REPEAT; r++) {
+        memcpy(x, b, N * sizeof(double));
+        tri_schedule_solve(&s, &m, x);
+    }
+    double t_level = (bench_now() - start) / REPEAT;
+    double err_level = max_diff(x, ref, N);
+
+    start = bench_now();
+    for (int r = 0; r < REPEAT; r++) {
+        memcpy(x, b, N * sizeof(double));
+        trsv_upper(A, N, x);
+    }
+    double t_trsv = (bench_now() - start) / REPEAT;
+    double err_trsv = max_diff(x, ref, N);
+
+    printf("%s: 非零元 %d，层数 %d（平均每层 %.1f 行）\n", title, m.row_ptr[N], s.levels, (double)N / s.levels);
+    printf("  逐行回代      %.3f ms\n", t_seq * 1e3);
+    printf("  层次调度 CSR  %.3f ms（分析 %.3f ms），与逐行回代的相对差 %e\n", t_level * 1e3, t_build * 1e3, err_level);
+    printf("  分块稠密 TRSV %.3f ms，与逐行回代的相对差 %e\n", t_trsv * 1e3, err_trsv);
+
+    tri_schedule_free(&s);
+    csr_free(&m);
+    arena_release(arena, mark);
+    return 0;
+}
+
+// 两种矩阵上的单右端项对比与多右端项 TRSM 对比；返回值同 compare
+int run(double **A, double *b, double *B, double *X, double *Bt, double *Xt, Arena *arena) {
+#ifdef _OPENMP
+    printf("线程数: %d\n", omp_get_max_threads());
+#endif
+
+    generate_sparse_upper_triangular_matrix(A, b, N, SPARSITY, SEED);
+    int info = compare("稀疏上三角（5%）", A, b, arena);
+    if (info != 0) return info;
+
+    // 多右端项：一次 TRSM 对比逐个右端项回代。逐个回代的右端项先在计时外转成按列连续存放，
+    // 两者计时都只包含求解本身
+    Rng rng;
+    rng_init(&rng, SEED);
+    rng_fill_uniform(&rng, B, (size_t)N * NRHS, -1, 1);
+    for (int i = 0; i < N; i++) {
+        for (int r = 0; r < NRHS; r++) {
+            Bt[(size_t)r * N + i] = B[(size_t)i * NRHS + r];
+        }
+    }
+    memcpy(X, B, (size_t)N * NRHS * sizeof(double));
+    double start = bench_now();
+    for (int r = 0; r < NRHS; r++) {
+        back_substitution(A, Bt + (size_t)r * N, Xt + (size_t)r * N);
+    }
+    double t_seq = bench_now() - start;
+    start = bench_now();
+    trsm_upper(A, N, X, NRHS);
+    double t_trsm = bench_now() - start;
+    for (int i = 0; i < N; i++) {
+        for (int r = 0; r < NRHS; r++) {
+            B[(size_t)i * NRHS + r] = Xt[(size_t)r * N + i];  // 逐个回代的结果转回按行存放以便比较
+        }
+    }
+    double err = max_diff(X, B, N * NRHS);
+    printf("%d 个右端项: 逐个回代 %.3f ms，TRSM %.3f ms，相对差 %e\n", NRHS, t_seq * 1e3, t_trsm * 1e3, err);
+
+    generate_very_sparse_upper_triangular_matrix(A);
+    return compare("极稀疏上三角（每行 4 个）", A, b, arena);
+}
+
+int main() {
+    Matrix a;
+    Arena arena;  // compare 的两个工作向量
+    int ok = matrix_alloc(&a, N, N) == 0;
+    ok = arena_init(&arena, arena_bytes(2, N)) == 0 && ok;
+    double *b = vector_alloc(N);
+    double *B = vector_alloc((size_t)N * NRHS);
+    double *X = vector_alloc((size_t)N * NRHS);
+    double *Bt = vector_alloc((size_t)N * NRHS);  // 按列连续存放的右端项与逐个回代的解
+    double *Xt = vector_alloc((size_t)N * NRHS);
+    int status = ok && b != NULL && B != NULL && X != NULL && Bt != NULL && Xt != NULL ? 0 : -1;
+    if (status == 0) status = run(a.row, b, B, X, Bt, Xt, &arena);
+    if (status > 0) {
+        printf("矩阵奇异（第 %d 行对角元为零），无法求解\n", status - 1);
+    } else if (status != 0) {
+        printf("内存分配失败\n");
+    }
+
+    matrix_free(&a);
+    arena_free(&arena);
+    vector_free(b);
+    vector_free(B);
+    vector_free(X);
+    vector_free(Bt);
+    vector_free(Xt);
+    return status == 0 ? 0 : -1;
+}
@@ -9,70 +9,29 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
-#include <time.h>
+#include "../common/sum.h"
+#include "../common/bench.h"
+#include "../common/trace.h"
+#include "../common/matrix.h"
+#include "../common/test_matrix.h"
+#include "jacobi.h"
 
 #define N 1000     // 矩阵阶数
 #define SPARSITY 0.05  // 稀疏度，表示非零元素占总元素的比例
+#define SEED 20241015  // 随机数种子，保证生成的测试矩阵可复现
 #define TOL 1e-6   // 误差容限
 #define MAX_ITER 10000  // 最大迭代次数
+#define PRINT_COUNT 10  // 输出解向量的前几个分量
 
-// 函数：生成稀疏上三角矩阵
-void generate_sparse_upper_triangular_matrix(double **A, double *b) {
-    srand(time(NULL));  // 初始化随机数种子
-
-    // 初始化稀疏矩阵
-    for (int i = 0; i < N; i++) {
-        b[i] = rand() % 10 + 1;  // 随机生成b向量
-
-        for (int j = 0; j < N; j++) {
-            if (j < i) {
-                A[i][j] = 0.0;  // 确保是上三角矩阵，主对角线以下的元素为0
-            } else if (i == j) {
-                A[i][j] = rand() % 10 + 5;  // 确保对角线上的元素较大，且不为零
-            } else if ((double) rand() / RAND_MAX < SPARSITY) {
-                A[i][j] = rand() % 5 + 1;  // 随机生成上三角区域的稀疏元素
-            } else {
-                A[i][j] = 0.0;  // 稀疏矩阵的其他位置为0
-            }
-        }
-    }
-}
-
-// 雅克比迭代求解
-void jacobi(double **A, double *b, double *x) {
-    double *x_new = (double *)malloc(N * sizeof(double));
+// 雅克比迭代求解；x_new 取自 arena（清零），迭代过程中不分配内存
+void jacobi(double **A, double *b, double *x, Arena *arena) {
+    size_t mark = arena_mark(arena);
+    double *x_new = arena_vector(arena, N);
     if (x_new == NULL) {
         printf("内存分配失败\n");
         return;
     }
-    int iter = 0;
-    double error;
-
-    // 初始化x_new为0
-    for (int i = 0; i < N; i++) {
-        x_new[i] = 0.0;
-    }
-
-    do {
-        error = 0.0;
-        for (int i = 0; i < N; i++) {
-            double sum = 0.0;
-            for (int j = 0; j < N; j++) {
-                if (i != j) {
-                    sum += A[i][j] * x[j];
-                }
-            }
-            x_new[i] = (b[i] - sum) / A[i][i];
-            error += fabs(x_new[i] - x[i]);
-        }
-
-        // 更新x
-        for (int i = 0; i < N; i++) {
-            x[i] = x_new[i];
-        }
-
-        iter++;
-    } while (error > TOL && iter < MAX_ITER);
+    int iter = jacobi_iterate(A, b, x, x_new, N, TOL, MAX_ITER);
 
     if (iter >= MAX_ITER) {
         printf("雅克比迭代未能在最大迭代次数内收敛\n");
@@ -80,64 +39,64 @@ void jacobi(double **A, double *b, double *x) {
         printf("雅克比迭代收敛于 %d 次迭代\n", iter);
     }
 
-    free(x_new);
+    arena_release(arena, mark);
 }
 
 // 函数：评估准确性
 double evaluate_accuracy(double *x, double *b, double **A) {
-    double error_sum = 0.0;
+    SumAcc error_sum = sum_acc_init();
     for (int i = 0; i < N; i++) {
-        double calculated_b = 0.0;
-        for (int j = 0; j < N; j++) {
-            calculated_b += A[i][j] * x[j];  // 计算 Ax_i
-        }
-        error_sum += fabs(b[i] - calculated_b);  // 计算 b - Ax 的绝对误差和
+        double calculated_b = sum_dot(A[i], x, N);  // 计算 Ax_i（补偿点积）
+        sum_acc_add(&error_sum, fabs(b[i] - calculated_b));  // 计算 b - Ax 的绝对误差和
     }
-    return error_sum;
+    return sum_acc_result(error_sum);
 }
 
 int main() {
-    double **A = (double **)malloc(N * sizeof(double *));
-    for (int i = 0; i < N; i++) {
-        A[i] = (double *)malloc(N * sizeof(double));
-    }
-    double *b = (double *)malloc(N * sizeof(double));
-    double *x = (double *)malloc(N * sizeof(double));  // 初始解向量为0
+    Matrix a;
+    Arena arena;  // 迭代用的临时向量
+    int ok = matrix_alloc(&a, N, N) == 0 && arena_init(&arena, arena_bytes(1, N)) == 0;
+    double *b = vector_alloc(N);
+    double *x = vector_alloc(N);  // 初始解向量为0
 
-    if (A == NULL || b == NULL || x == NULL) {
+    if (!ok || b == NULL || x == NULL) {
         printf("内存分配失败\n");
         return -1;
     }
+    double **A = a.row;
 
     // 调用生成稀疏上三角矩阵的函数
-    generate_sparse_upper_triangular_matrix(A, b);
+    generate_sparse_upper_triangular_matrix(A, b, N, SPARSITY, SEED);
 
-    // 开始计时
-    clock_t start_time = clock();
+    // 开始计时；启用 NUMERIC_TRACE 时收敛轨迹写到 jacobi_trace.csv
+    TraceSession trace;
+    trace_session_begin(&trace, "jacobi_trace.csv", TRACE_CSV);
+    double start_time = bench_now();
 
     // 使用雅克比迭代法求解
-    jacobi(A, b, x);
+    jacobi(A, b, x, &arena);
 
     // 结束计时
-    clock_t end_time = clock();
-    double elapsed_time = (double)(end_time - start_time) / CLOCKS_PER_SEC;
+    double elapsed_time = bench_now() - start_time;
     printf("雅克比迭代法运行时间: %f 秒\n", elapsed_time);
+    if (trace.active) {
+        long dropped = (long) trace.ring.dropped;
+        printf("收敛轨迹: %ld 条写入 jacobi_trace.csv，丢弃 %ld 条\n", trace_session_end(&trace), dropped);
+    }
 
     // 评估解的准确性
     double accuracy = evaluate_accuracy(x, b, A);
     printf("解的准确性误差总和: %f\n", accuracy);
 
     // 输出解向量的前10个值
-    for (int i = 0; i < N; i++) {
+    for (int i = 0; i < PRINT_COUNT; i++) {
         printf("x[%d] = %f\n", i, x[i]);
     }
 
-    for (int i = 0; i < N; i++) {
-        free(A[i]);
-    }
-    free(A);
-    free(b);
-    free(x);
+    matrix_free(&a);
+    arena_free(&arena);
+    vector_free(b);
+    vector_free(x);
 
     return 0;
 }
@@ -0,0 +1,260 @@
+/**
+ * @Descripttion: 流式最小二乘多项式拟合：分块 Householder QR 增量累积（TSQR），分块并行 + 树形合并，批量拟合多条序列
+ * @filename: least_squares.hpp
+ * @Author: 王春博
+ * @Date: 2026.10.19
+ * @Version: V1.0
+ *
+ * 只保存增广上三角因子 [R | Q^T y]（p 行 p + nrhs 列，p = 次数 + 1）与各右端项的残差平方和，
+ * 内存 O(p^2)，与样本数无关。每来一块样本，把 [R; 块] 用 Householder 变换重新化为上三角：
+ * 第 k 个反射只涉及 R 的第 k 行与块中的 m 行，代价 O(m p^2)；被旋出的右端分量即残差，累加其平方。
+ * 两个累积器的合并就是把一方的 R 当作 p 行样本吸收进另一方，因此分块可以并行累积再两两合并。
+ * 不形成法方程 X^T X，条件数不会被平方。
+ * 基函数用区间 [lo, hi] 上的切比雪夫多项式 T_k(t)，t = (2x - lo - hi) / (hi - lo)，比单项式好得多；
+ * lsq_to_monomial 可换算成 x 的幂次系数。
+ */
+
+#ifndef LEAST_SQUARES_HPP
+#define LEAST_SQUARES_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#include "../common/poly.hpp"
+
+#define LSQ_CHUNK 1024          // 并行拟合时每块的样本数
+#define LSQ_PARALLEL_MIN 16384  // 样本数（或批量拟合的序列数乘次数）达到此数才并行
+
+// 拟合结果：coef 为切比雪夫系数，status 为 0 表示成功，k + 1 表示第 k 列数值秩亏（R[k][k] 相对过小），-1 表示参数非法
+struct LsqFit {
+    double lo = -1.0;
+    double hi = 1.0;
+    std::vector<double> coef;
+    double rss = 0.0;  // 残差平方和
+    long count = 0;    // 样本数
+    int status = -1;
+
+    double operator()(double x) const {
+        if (coef.empty()) return 0.0;
+        return poly_clenshaw(coef.data(), (int) coef.size() - 1, (2.0 * x - lo - hi) / (hi - lo));
+    }
+};
+
+class LsqAccumulator {
+public:
+    LsqAccumulator() = default;
+
+    // degree 次多项式，样本 x 应落在 [lo, hi]，nrhs 个右端项（多条序列共用同一组 x 时）
+    LsqAccumulator(int degree, double lo, double hi, int nrhs = 1)
+        : p_(degree + 1), nrhs_(nrhs), lo_(lo), hi_(hi), R_((size_t) p_ * (p_ + nrhs), 0.0), rss_(nrhs, 0.0) {}
+
+    int terms() const { return p_; }
+    long count() const { return count_; }
+
+    // 吸收 m 个样本；y 按右端项分列存放：y[r * ldy + i] 为第 r 条序列的第 i 个值
+    void add(const double *x, const double *y, int m, int ldy) {
+        if (m <= 0) return;
+        int cols = p_ + nrhs_;
+        std::vector<double> w((size_t) m * cols);  // 按列存放的块：w[j * m + i]
+        double scale = 2.0 / (hi_ - lo_), shift = -(lo_ + hi_) / (hi_ - lo_);
+        for (int i = 0; i < m; i++) {
+            double t = x[i] * scale + shift;
+            double prev = 1.0, cur = t;
+            w[i] = 1.0;
+            if (p_ > 1) w[(size_t) m + i] = t;
+            for (int k = 2; k < p_; k++) {
+                double next = 2.0 * t * cur - prev;
+                w[(size_t) k * m + i] = next;
+                prev = cur;
+                cur = next;
+            }
+        }
+        for (int r = 0; r < nrhs_; r++) {
+            for (int i = 0; i < m; i++) w[(size_t) (p_ + r) * m + i] = y[(long) r * ldy + i];
+        }
+        absorb(w.data(), m);
+        count_ += m;
+    }
+
+    void add(const double *x, const double *y, int m) { add(x, y, m, m); }
+
+    // 合并另一个同规格的累积器：把它的 R 当作 p 行样本吸收
+    void merge(const LsqAccumulator &other) {
+        int cols = p_ + nrhs_;
+        std::vector<double> w((size_t) p_ * cols);
+        for (int i = 0; i < p_; i++) {
+            for (int j = 0; j < cols; j++) w[(size_t) j * p_ + i] = other.R_[(size_t) i * cols + j];
+        }
+        absorb(w.data(), p_);
+        for (int r = 0; r < nrhs_; r++) rss_[r] += other.rss_[r];
+        count_ += other.count_;
+    }
+
+    // 回代求第 rhs 个右端项的系数
+    LsqFit solve(int rhs = 0) const {
+        LsqFit fit;
+        fit.lo = lo_;
+        fit.hi = hi_;
+        fit.count = count_;
+        if (p_ < 1 || rhs < 0 || rhs >= nrhs_) return fit;
+        int cols = p_ + nrhs_;
+        double rmax = 0.0;
+        for (int k = 0; k < p_; k++) rmax = std::fmax(rmax, std::fabs(R_[(size_t) k * cols + k]));
+        fit.coef.assign(p_, 0.0);
+        fit.status = 0;
+        for (int k = p_ - 1; k >= 0; k--) {
+            const double *row = &R_[(size_t) k * cols];
+            if (!(std::fabs(row[k]) > 1e-13 * rmax)) {
+                fit.status = k + 1;
+                continue;  // 秩亏的分量取 0
+            }
+            double s = row[p_ + rhs];
+            for (int j = k + 1; j < p_; j++) s -= row[j] * fit.coef[j];
+            fit.coef[k] = s / row[k];
+        }
+        fit.rss = rss_[rhs];
+        return fit;
+    }
+
+private:
+    // 把 m 行的块（按列存放，p + nrhs 列）并入 R：逐列构造 Householder 反射，作用于 R 的第 k 行与块
+    void absorb(double *w, int m) {
+        int cols = p_ + nrhs_;
+        for (int k = 0; k < p_; k++) {
+            double *wk = w + (size_t) k * m;
+            double alpha = R_[(size_t) k * cols + k];
+            double sigma = 0.0;
+            #pragma omp simd reduction(+ : sigma)
+            for (int i = 0; i < m; i++) sigma += wk[i] * wk[i];
+            if (sigma == 0.0) continue;  // 块在这一列已为 0，无需反射
+            double beta = -std::copysign(std::sqrt(alpha * alpha + sigma), alpha);
+            double tau = (beta - alpha) / beta;
+            double inv = 1.0 / (alpha - beta);
+            #pragma omp simd
+            for (int i = 0; i < m; i++) wk[i] *= inv;  // 反射向量 u = [1; wk]
+            R_[(size_t) k * cols + k] = beta;
+            for (int j = k + 1; j < cols; j++) {
+                double *wj = w + (size_t) j * m;
+                double s = R_[(size_t) k * cols + j];
+                #pragma omp simd reduction(+ : s)
+                for (int i = 0; i < m; i++) s += wk[i] * wj[i];
+                s *= tau;
+                R_[(size_t) k * cols + j] -= s;
+                #pragma omp simd
+                for (int i = 0; i < m; i++) wj[i] -= s * wk[i];
+            }
+        }
+        // 前 p 列已化为 0，右端列剩下的就是残差分量
+        for (int r = 0; r < nrhs_; r++) {
+            const double *wr = w + (size_t) (p_ + r) * m;
+            double s = 0.0;
+            #pragma omp simd reduction(+ : s)
+            for (int i = 0; i < m; i++) s += wr[i] * wr[i];
+            rss_[r] += s;
+        }
+    }
+
+    int p_ = 0;
+    int nrhs_ = 1;
+    double lo_ = -1.0;
+    double hi_ = 1.0;
+    std::vector<double> R_;  // p 行 p + nrhs 列，按行存放
+    std::vector<double> rss_;
+    long count_ = 0;
+};
+
+// 一次拟合 n 个样本：每个线程一个累积器，依次吸收静态划分给它的各块（每块 LSQ_CHUNK 个样本），
+// 再逐层两两合并（TSQR 归约树）。内存 O(线程数 * p^2)，与样本数无关；结果随线程数只有舍入级别的差异
+inline LsqFit lsq_polyfit(const double *x, const double *y, long n, int degree, double lo, double hi) {
+    if (degree < 0 || n < 1 || !(hi > lo)) return LsqFit();
+    long chunks = (n + LSQ_CHUNK - 1) / LSQ_CHUNK;
+    int threads = 1;
+#ifdef _OPENMP
+    if (n >= LSQ_PARALLEL_MIN) threads = (int) std::min<long>(omp_get_max_threads(), chunks);
+#endif
+    std::vector<LsqAccumulator> acc(threads, LsqAccumulator(degree, lo, hi));
+    #pragma omp parallel num_threads(threads) if (threads > 1)
+    {
+        int t = 0;
+#ifdef _OPENMP
+        t = omp_get_thread_num();
+#endif
+        #pragma omp for schedule(static)
+        for (long c = 0; c < chunks; c++) {
+            long start = c * LSQ_CHUNK;
+            int m = (int) (n - start < LSQ_CHUNK ? n - start : LSQ_CHUNK);
+            acc[t].add(x + start, y + start, m);
+        }
+    }
+    for (int step = 1; step < threads; step *= 2) {
+        for (int t = 0; t < threads - step; t += 2 * step) acc[t].merge(acc[t + step]);
+    }
+    return acc[0].solve();
+}
+
+// 批量拟合共用同一组 x 的 series 条序列：QR 只做一次，各序列作为不同右端项；y[s * n + i] 为第 s 条的第 i 个值
+inline std::vector<LsqFit> lsq_polyfit_shared(const double *x, const double *y, int n, int series, int degree,
+                                              double lo, double hi) {
+    std::vector<LsqFit> fits(series > 0 ? series : 0);
+    if (degree < 0 || n < 1 || series < 1 || !(hi > lo)) return fits;
+    LsqAccumulator acc(degree, lo, hi, series);
+    for (int start = 0; start < n; start += LSQ_CHUNK) {
+        int m = n - start < LSQ_CHUNK ? n - start : LSQ_CHUNK;
+        acc.add(x + start, y + start, m, n);
+    }
+    #pragma omp parallel for schedule(static) if ((long) series * degree >= LSQ_PARALLEL_MIN)
+    for (int s = 0; s < series; s++) fits[s] = acc.solve(s);
+    return fits;
+}
+
+// 批量拟合各自采样的 series 条序列：第 s 条的样本为下标 offset[s] .. offset[s + 1] - 1，区间 [lo[s], hi[s]]
+inline std::vector<LsqFit> lsq_polyfit_batch(const double *x, const double *y, const long *offset, int series,
+                                             int degree, const double *lo, const double *hi) {
+    std::vector<LsqFit> fits(series > 0 ? series : 0);
+    #pragma omp parallel for schedule(dynamic, 16) if ((long) series * degree >= LSQ_PARALLEL_MIN)
+    for (int s = 0; s < series; s++) {
+        long start = offset[s], n = offset[s + 1] - offset[s];
+        if (degree < 0 || n < 1 || !(hi[s] > lo[s])) continue;
+        LsqAccumulator acc(degree, lo[s], hi[s]);
+        for (long k = 0; k < n; k += LSQ_CHUNK) {
+            int m = (int) (n - k < LSQ_CHUNK ? n - k : LSQ_CHUNK);
+            acc.add(x + start + k, y + start + k, m);
+        }
+        fits[s] = acc.solve();
+    }
+    return fits;
+}
+
+// 换算为 x 的幂次系数（升幂）：mono[k] 为 x^k 的系数
+inline std::vector<double> lsq_to_monomial(const LsqFit &fit) {
+    int p = (int) fit.coef.size();
+    std::vector<double> mono(p, 0.0);
+    if (p == 0) return mono;
+    // 先求 t 的幂次系数：T_k 按 T_{k+1} = 2t T_k - T_{k-1} 展开
+    std::vector<double> tk_prev(p, 0.0), tk(p, 0.0), tk_next(p, 0.0), in_t(p, 0.0);
+    tk_prev[0] = 1.0;
+    in_t[0] += fit.coef[0];
+    if (p > 1) {
+        tk[1] = 1.0;
+        in_t[1] += fit.coef[1];
+    }
+    for (int k = 2; k < p; k++) {
+        for (int j = 0; j < p; j++) tk_next[j] = (j > 0 ? 2.0 * tk[j - 1] : 0.0) - tk_prev[j];
+        for (int j = 0; j <= k; j++) in_t[j] += fit.coef[k] * tk_next[j];
+        tk_prev.swap(tk);
+        tk.swap(tk_next);
+    }
+    // 再代入 t = a x + b：按 Horner 展开 Σ in_t[k] (a x + b)^k
+    double a = 2.0 / (fit.hi - fit.lo), b = -(fit.lo + fit.hi) / (fit.hi - fit.lo);
+    for (int k = p - 1; k >= 0; k--) {
+        // mono <- mono * (a x + b) + in_t[k]
+        for (int j = p - 1; j >= 0; j--) mono[j] = mono[j] * b + (j > 0 ? mono[j - 1] * a : 0.0);
+        mono[0] += in_t[k];
+    }
+    return mono;
+}
+
+#endif // LEAST_SQUARES_HPP
@@ -0,0 +1,151 @@
+/***
+ * 最小二乘多项式拟合：作业中的半圆五次拟合，与法方程的精度比较，流式累积与分块并行，批量拟合多条序列
+ * @Date 2026/10/19
+ * @Author: 王春博
+ */
+#include <cstdio>
+#include <cmath>
+#include <vector>
+#include "least_squares.hpp"
+#include "../第四周/lu.hpp"
+#include "../common/bench.h"
+#include "../common/rng.h"
+
+#define STREAM_SAMPLES 10000000  // 流式拟合的样本总数
+#define STREAM_CHUNK 4096        // 流式拟合每次到达的样本数
+#define BATCH_SERIES 10000       // 批量拟合的序列条数
+#define BATCH_POINTS 200         // 每条序列的样本数
+
+// 测试多项式：[0, 10] 上的 12 次多项式，切比雪夫系数按 0.5^k 衰减
+double truth(double x) {
+    double t = (2.0 * x - 10.0) / 10.0, prev = 1.0, cur = t, sum = 1.0 + 0.5 * t, w = 0.5;
+    for (int k = 2; k <= 12; k++) {
+        double next = 2.0 * t * cur - prev;
+        w *= 0.5;
+        sum += w * next;
+        prev = cur;
+        cur = next;
+    }
+    return sum;
+}
+
+// 法方程 + 单项式基：X^T X c = X^T y，用 LU 求解
+std::vector<double> normal_equations(const std::vector<double> &x, const std::vector<double> &y, int degree) {
+    int p = degree + 1;
+    std::vector<double> A((size_t) p * p, 0.0), b(p, 0.0), pw(2 * p - 1);
+    for (size_t i = 0; i < x.size(); i++) {
+        pw[0] = 1.0;
+        for (int k = 1; k < 2 * p - 1; k++) pw[k] = pw[k - 1] * x[i];
+        for (int r = 0; r < p; r++) {
+            for (int c = 0; c < p; c++) A[(size_t) r * p + c] += pw[r + c];
+            b[r] += pw[r] * y[i];
+        }
+    }
+    std::vector<int> perm(p);
+    lu_factor(A.data(), p, p, perm.data());
+    lu_solve(A.data(), p, p, perm.data(), b.data());
+    return b;
+}
+
+double horner(const std::vector<double> &mono, double x) {
+    double v = 0.0;
+    for (int k = (int) mono.size() - 1; k >= 0; k--) v = v * x + mono[k];
+    return v;
+}
+
+int main() {
+    // 作业：单位半圆上均匀取 30 个点，五次拟合
+    const int N = 30, degree = 5;
+    std::vector<double> xs(N), ys(N);
+    for (int i = 0; i < N; i++) {
+        xs[i] = cos(M_PI * i / (N - 1));
+        ys[i] = sin(M_PI * i / (N - 1));
+    }
+    LsqFit fit = lsq_polyfit(xs.data(), ys.data(), N, degree, -1, 1);
+    std::vector<double> mono = lsq_to_monomial(fit);
+    printf("Fitted polynomial coefficients: [");
+    for (int k = degree; k >= 0; k--) printf("%s%.8e", k == degree ? "" : " ", mono[k]);  // 与 np.polyfit 相同，降幂
+    printf("]\nMean Squared Error (MSE): %.5f\n", fit.rss / N);  // 残差平方和由 QR 直接给出
+
+    // 条件数：[0, 10] 上 12 次拟合，单项式法方程 vs 切比雪夫基 QR
+    const int M = 100000;
+    std::vector<double> x(M), y(M);
+    Rng rng;
+    rng_init(&rng, 20261019);
+    for (int i = 0; i < M; i++) {
+        x[i] = rng_uniform_range(&rng, 0, 10);
+        y[i] = truth(x[i]);
+    }
+    std::vector<double> ne = normal_equations(x, y, 12);
+    LsqFit qr = lsq_polyfit(x.data(), y.data(), M, 12, 0, 10);
+    double err_ne = 0.0, err_qr = 0.0;
+    for (int i = 0; i <= 1000; i++) {
+        double xi = 0.01 * i;
+        err_ne = fmax(err_ne, fabs(horner(ne, xi) - truth(xi)));
+        err_qr = fmax(err_qr, fabs(qr(xi) - truth(xi)));
+    }
+    printf("12 次无噪声拟合的最大误差: 单项式法方程 %.2e，QR %.2e\n", err_ne, err_qr);
+
+    // 流式：样本逐块到达，只保存 13 x 14 的因子
+    double t0 = bench_now();
+    LsqAccumulator stream(12, 0, 10);
+    std::vector<double> cx(STREAM_CHUNK), cy(STREAM_CHUNK);
+    for (long done = 0; done < STREAM_SAMPLES; done += STREAM_CHUNK) {
+        for (int i = 0; i < STREAM_CHUNK; i++) {
+            cx[i] = rng_uniform_range(&rng, 0, 10);
+            cy[i] = truth(cx[i]) + 1e-3 * (rng_uniform(&rng) - 0.5);
+        }
+        stream.add(cx.data(), cy.data(), STREAM_CHUNK);
+    }
+    LsqFit streamed = stream.solve();
+    double t1 = bench_now();
+    double coef_err = 0.0, w = 1.0;
+    for (int k = 0; k <= 12; k++) {
+        coef_err = fmax(coef_err, fabs(streamed.coef[k] - w));
+        w *= 0.5;
+    }
+    printf("流式拟合 %d 个样本: %.3f s（含生成样本），系数最大误差 %.2e，残差均方根 %.3e（噪声约 %.3e）\n",
+           STREAM_SAMPLES, t1 - t0, coef_err, sqrt(streamed.rss / streamed.count), 1e-3 / sqrt(12.0));
+
+    // 同样规模一次给出：分块并行 + 树形合并
+    x.resize(STREAM_SAMPLES);
+    y.resize(STREAM_SAMPLES);
+    for (long i = 0; i < STREAM_SAMPLES; i++) {
+        x[i] = rng_uniform_range(&rng, 0, 10);
+        y[i] = truth(x[i]) + 1e-3 * (rng_uniform(&rng) - 0.5);
+    }
+    t0 = bench_now();
+    LsqFit tree = lsq_polyfit(x.data(), y.data(), STREAM_SAMPLES, 12, 0, 10);
+    t1 = bench_now();
+    double diff = 0.0;
+    for (int k = 0; k <= 12; k++) diff = fmax(diff, fabs(tree.coef[k] - streamed.coef[k]));
+    printf("分块并行 + 树形合并: %.3f s，与流式结果的系数最大差 %.2e\n", t1 - t0, diff);
+
+    // 批量：BATCH_SERIES 条序列，三次拟合
+    std::vector<double> grid(BATCH_POINTS), values((size_t) BATCH_SERIES * BATCH_POINTS);
+    std::vector<double> bx((size_t) BATCH_SERIES * BATCH_POINTS), blo(BATCH_SERIES, 0.0), bhi(BATCH_SERIES, 1.0);
+    std::vector<long> offset(BATCH_SERIES + 1);
+    for (int i = 0; i < BATCH_POINTS; i++) grid[i] = (double) i / (BATCH_POINTS - 1);
+    for (int s = 0; s < BATCH_SERIES; s++) {
+        double a = rng_uniform_range(&rng, -1, 1), b = rng_uniform_range(&rng, -1, 1);
+        for (int i = 0; i < BATCH_POINTS; i++) {
+            bx[(size_t) s * BATCH_POINTS + i] = grid[i];
+            values[(size_t) s * BATCH_POINTS + i] = a * sin(3 * grid[i]) + b * grid[i] * grid[i];
+        }
+        offset[s] = (long) s * BATCH_POINTS;
+    }
+    offset[BATCH_SERIES] = (long) BATCH_SERIES * BATCH_POINTS;
+    t0 = bench_now();
+    std::vector<LsqFit> shared = lsq_polyfit_shared(grid.data(), values.data(), BATCH_POINTS, BATCH_SERIES, 3, 0, 1);
+    t1 = bench_now();
+    std::vector<LsqFit> each = lsq_polyfit_batch(bx.data(), values.data(), offset.data(), BATCH_SERIES, 3, blo.data(),
+                                                 bhi.data());
+    double t2 = bench_now();
+    diff = 0.0;
+    for (int s = 0; s < BATCH_SERIES; s++) {
+        for (int k = 0; k <= 3; k++) diff = fmax(diff, fabs(shared[s].coef[k] - each[s].coef[k]));
+    }
+    printf("批量 %d 条 x %d 点三次拟合: 共用 x（一次 QR）%.2f ms，各自 x %.2f ms，系数最大差 %.2e\n", BATCH_SERIES,
+           BATCH_POINTS, (t1 - t0) * 1e3, (t2 - t1) * 1e3, diff);
+    return 0;
+}
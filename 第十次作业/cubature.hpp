@@ -0,0 +1,437 @@
+/**
+ * @Descripttion: 多维盒形区域求积：张量积辛卜生/高斯规则 + 自适应细分，以及 Sobol 拟蒙特卡罗
+ * @filename: cubature.hpp
+ * @Author: 王春博
+ * @Date: 2026.10.19
+ * @Version: V1.0
+ */
+
+#ifndef CUBATURE_HPP
+#define CUBATURE_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include "../common/rng.h"
+#include "../common/sum.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#define CUBATURE_MAX_TENSOR_DIM 6   // 张量积规则的最大维数（5^6 = 15625 个节点）
+#define CUBATURE_MAX_SOBOL_DIM 16   // Sobol 序列支持的最大维数
+#define CUBATURE_BLOCK 256          // 分块求值时每块的点数
+#define CUBATURE_MAX_SOBOL_POINTS (1LL << 32)  // Sobol 点的序号只有 32 位方向数，点数不能超过 2^32
+#define CUBATURE_LINE_POINTS 5      // 每维中心线上用于差分的点数
+
+enum class CubatureRule {
+    Simpson,  // 每维 3 点辛卜生
+    Gauss     // 每维 5 点高斯-勒让德
+};
+
+// 求积结果：status 为 0 表示达到精度，1 表示求值次数用尽，-1 表示参数非法
+struct CubatureResult {
+    double value;
+    double error;
+    long evaluations;
+    int status;
+};
+
+namespace cubature_detail {
+
+// 一维参考规则（区间 [-1, 1]）；low 是只用部分节点的嵌入低阶规则，权为 0 的节点不参与。
+// extra 是只为差分补充的中心线节点，与规则节点合起来每维恰好 CUBATURE_LINE_POINTS 个，用来算四阶差分。
+// order 与 low_order 为两规则的误差阶（误差约为 h^order），用于把嵌入差换算为高阶规则的误差
+struct Rule1D {
+    int n;
+    double node[5];
+    double weight[5];
+    double low[5];
+    int extra;
+    double extra_node[2];
+    int order;
+    int low_order;
+};
+
+inline Rule1D rule_1d(CubatureRule rule) {
+    if (rule == CubatureRule::Simpson) {
+        // 嵌入梯形公式；中心线补 ±1/2 两点
+        return {3, {-1.0, 0.0, 1.0}, {1.0 / 3, 4.0 / 3, 1.0 / 3}, {1.0, 0.0, 1.0}, 2, {-0.5, 0.5}, 4, 2};
+    }
+    // 嵌入 {-x4, 0, x4} 三点插值公式（代数精度 3）
+    const double a = 0.9061798459386640;
+    return {5,
+            {-a, -0.5384693101056831, 0.0, 0.5384693101056831, a},
+            {0.2369268850561891, 0.4786286704993665, 0.5688888888888889, 0.4786286704993665, 0.2369268850561891},
+            {1 / (3 * a * a), 0.0, 2 - 2 / (3 * a * a), 0.0, 1 / (3 * a * a)},
+            0,
+            {0.0, 0.0},
+            10,
+            4};
+}
+
+// 每个子区域的求值次数：张量积节点加各维中心线上的补充节点
+inline long rule_points(const Rule1D &r, int dim) {
+    long total = 1;
+    for (int d = 0; d < dim; d++) total *= r.n;
+    return total + (long) r.extra * dim;
+}
+
+// 自适应细分中的子区域
+struct Region {
+    std::vector<double> lo, hi;
+    double value;
+    double error;
+    int split_dim;
+};
+
+inline bool region_less(const Region &a, const Region &b) {
+    return a.error < b.error;
+}
+
+// 节点 t[0..m-1] 上的 m - 1 阶差商（就地改写 g）
+inline double divided_difference(const double *t, double *g, int m) {
+    for (int k = 1; k < m; k++) {
+        for (int i = m - 1; i >= k; i--) g[i] = (g[i] - g[i - 1]) / (t[i] - t[i - k]);
+    }
+    return g[m - 1];
+}
+
+// 在子区域上分块计算张量积规则，并按维度给出误差估计与下一次的细分方向（Genz-Malik 式）：
+// 第 d 维的嵌入差 E_d 是只在该维换用低阶权得到的差值，量级为 h^low_order。中心线上四阶与二阶差分之比
+// rho_d ~ h^2 f^(4) / f^(2) 是误差阶每升两阶缩小的比例，于是高阶规则在该维的误差约为 E_d * rho_d^((order - low_order) / 2)。
+// 各维误差之和作为区域误差，误差最大的维度作为细分方向
+template <class F>
+void apply_tensor_rule(F &f, const Rule1D &r, int dim, Region &reg, std::vector<double> &pts, std::vector<double> &vals) {
+    long total = 1;
+    for (int d = 0; d < dim; d++) total *= r.n;
+    pts.resize((size_t) CUBATURE_BLOCK * dim);
+    vals.resize((size_t) total);
+
+    double center[CUBATURE_MAX_TENSOR_DIM], half[CUBATURE_MAX_TENSOR_DIM];
+    double volume = 1.0;
+    for (int d = 0; d < dim; d++) {
+        center[d] = 0.5 * (reg.lo[d] + reg.hi[d]);
+        half[d] = 0.5 * (reg.hi[d] - reg.lo[d]);
+        volume *= half[d];
+    }
+
+    // 先把一块节点写入连续缓冲区，再整块求值
+    int idx[CUBATURE_MAX_TENSOR_DIM] = {0};
+    for (long start = 0; start < total; start += CUBATURE_BLOCK) {
+        int count = (int) std::min<long>(CUBATURE_BLOCK, total - start);
+        for (int p = 0; p < count; p++) {
+            for (int d = 0; d < dim; d++) {
+                pts[(size_t) p * dim + d] = center[d] + half[d] * r.node[idx[d]];
+            }
+            for (int d = 0; d < dim; d++) {
+                if (++idx[d] < r.n) break;
+                idx[d] = 0;
+            }
+        }
+        for (int p = 0; p < count; p++) {
+            vals[start + p] = f(&pts[(size_t) p * dim]);
+        }
+    }
+    // 中心线上的补充节点（至多 2 * CUBATURE_MAX_TENSOR_DIM 个，一块放得下）
+    double extra_vals[CUBATURE_MAX_TENSOR_DIM][2];
+    for (int d = 0; d < dim; d++) {
+        for (int e = 0; e < r.extra; e++) {
+            double *x = &pts[(size_t) (d * r.extra + e) * dim];
+            for (int q = 0; q < dim; q++) x[q] = center[q];
+            x[d] += half[d] * r.extra_node[e];
+            extra_vals[d][e] = f(x);
+        }
+    }
+
+    // 加权求和；sum_low[d] 只在第 d 维换用低阶权
+    double sum = 0.0, sum_low[CUBATURE_MAX_TENSOR_DIM] = {0.0};
+    for (long k = 0; k < total; k++) {
+        long rem = k;
+        int node[CUBATURE_MAX_TENSOR_DIM];
+        double w = 1.0;
+        for (int d = 0; d < dim; d++) {
+            node[d] = (int) (rem % r.n);
+            w *= r.weight[node[d]];
+            rem /= r.n;
+        }
+        sum += w * vals[k];
+        for (int d = 0; d < dim; d++) sum_low[d] += w * (r.low[node[d]] / r.weight[node[d]]) * vals[k];
+    }
+    reg.value = sum * volume;
+
+    // 各维中心线：规则节点与补充节点合并排序，在参考坐标下求差分，即 h^4 f^(4) 与 h^2 f^(2) 的量级
+    int mid = r.n / 2;
+    long center_index = 0, stride = 1;
+    for (int d = 0; d < dim; d++) {
+        center_index += mid * stride;
+        stride *= r.n;
+    }
+    int gap = (r.order - r.low_order) / 2;
+    double error = 0.0, best = -1.0;
+    reg.split_dim = 0;
+    stride = 1;
+    for (int d = 0; d < dim; d++) {
+        double t[CUBATURE_LINE_POINTS], g[CUBATURE_LINE_POINTS];
+        int m = 0;
+        for (int i = 0; i < r.n; i++, m++) {
+            t[m] = r.node[i];
+            g[m] = vals[center_index + (i - mid) * stride];
+        }
+        for (int e = 0; e < r.extra; e++, m++) {
+            t[m] = r.extra_node[e];
+            g[m] = extra_vals[d][e];
+        }
+        for (int i = 1; i < m; i++) {
+            for (int j = i; j > 0 && t[j] < t[j - 1]; j--) {
+                std::swap(t[j], t[j - 1]);
+                std::swap(g[j], g[j - 1]);
+            }
+        }
+        double outer_t[3] = {t[0], t[m / 2], t[m - 1]}, outer_g[3] = {g[0], g[m / 2], g[m - 1]};
+        double d2 = fabs(2.0 * divided_difference(outer_t, outer_g, 3));
+        double d4 = fabs(24.0 * divided_difference(t, g, m));
+        double rho = d4 == 0.0 ? 0.0 : (d4 < d2 ? d4 / d2 : 1.0);
+        double e_d = fabs(sum - sum_low[d]) * volume * pow(rho, gap);
+        error += e_d;
+        if (e_d > best * (1 + 1e-12)) {
+            best = e_d;
+            reg.split_dim = d;
+        }
+        stride *= r.n;
+    }
+    reg.error = error;
+    if (best == 0.0) {
+        for (int d = 1; d < dim; d++) {
+            if (half[d] > half[reg.split_dim]) reg.split_dim = d;
+        }
+    }
+}
+
+// Joe-Kuo 方向数表（维度 2..16）：多项式次数 s、系数 a、初始值 m
+struct SobolPoly {
+    int s;
+    unsigned a;
+    unsigned m[6];
+};
+
+static const SobolPoly sobol_table[CUBATURE_MAX_SOBOL_DIM - 1] = {
+        {1, 0, {1}},
+        {2, 1, {1, 3}},
+        {3, 1, {1, 3, 1}},
+        {3, 2, {1, 1, 1}},
+        {4, 1, {1, 1, 3, 3}},
+        {4, 4, {1, 3, 5, 13}},
+        {5, 2, {1, 1, 5, 5, 17}},
+        {5, 4, {1, 1, 5, 5, 5}},
+        {5, 7, {1, 1, 7, 11, 19}},
+        {5, 11, {1, 1, 5, 1, 1}},
+        {5, 13, {1, 1, 1, 3, 11}},
+        {5, 14, {1, 3, 5, 5, 31}},
+        {6, 1, {1, 3, 3, 9, 7, 49}},
+        {6, 13, {1, 1, 1, 15, 21, 21}},
+        {6, 16, {1, 3, 1, 13, 27, 49}},
+};
+
+}  // namespace cubature_detail
+
+// Sobol 低差异序列（32 位，格雷码顺序），可从任意下标直接定位，便于并行分块
+class SobolSequence {
+public:
+    explicit SobolSequence(int dim) : dim_(dim) {
+        for (int i = 0; i < 32; i++) v_[0][i] = 1u << (31 - i);
+        for (int d = 1; d < dim; d++) {
+            const cubature_detail::SobolPoly &p = cubature_detail::sobol_table[d - 1];
+            for (int i = 0; i < p.s; i++) v_[d][i] = p.m[i] << (31 - i);
+            for (int i = p.s; i < 32; i++) {
+                uint32_t value = v_[d][i - p.s] ^ (v_[d][i - p.s] >> p.s);
+                for (int k = 1; k < p.s; k++) {
+                    if ((p.a >> (p.s - 1 - k)) & 1u) value ^= v_[d][i - k];
+                }
+                v_[d][i] = value;
+            }
+        }
+    }
+
+    int dim() const { return dim_; }
+
+    // 计算第 index 个点（整数形式）
+    void point(uint64_t index, uint32_t *x) const {
+        uint64_t gray = index ^ (index >> 1);
+        for (int d = 0; d < dim_; d++) {
+            uint32_t value = 0;
+            for (int bit = 0; bit < 32 && (gray >> bit) != 0; bit++) {
+                if ((gray >> bit) & 1u) value ^= v_[d][bit];
+            }
+            x[d] = value;
+        }
+    }
+
+    // 由第 index 个点递推到第 index+1 个点，要求 index + 1 < 2^32
+    void next(uint64_t index, uint32_t *x) const {
+        int bit = 0;
+        while ((index >> bit) & 1u) bit++;
+        for (int d = 0; d < dim_; d++) x[d] ^= v_[d][bit];
+    }
+
+private:
+    int dim_;
+    uint32_t v_[CUBATURE_MAX_SOBOL_DIM][32];
+};
+
+// 自适应张量积求积：每轮取误差最大的若干子区域沿选定维度二分，子区域并行求值
+template <class F>
+CubatureResult adaptive_cubature(F f, int dim, const double *lo, const double *hi,
+                                 double abs_tol, double rel_tol, long max_eval,
+                                 CubatureRule rule = CubatureRule::Gauss) {
+    using namespace cubature_detail;
+    CubatureResult result = {0.0, 0.0, 0, -1};
+    if (dim < 1 || dim > CUBATURE_MAX_TENSOR_DIM) return result;
+
+    Rule1D r = rule_1d(rule);
+    long per_region = rule_points(r, dim);
+
+    std::vector<double> pts, vals;
+    Region root;
+    root.lo.assign(lo, lo + dim);
+    root.hi.assign(hi, hi + dim);
+    apply_tensor_rule(f, r, dim, root, pts, vals);
+    result.evaluations = per_region;
+
+    std::vector<Region> heap;
+    heap.push_back(root);
+    int batch = 16;
+#ifdef _OPENMP
+    batch = std::max(batch, 4 * omp_get_max_threads());
+#endif
+
+    while (true) {
+        SumAcc value_acc = sum_acc_init(), error_acc = sum_acc_init();
+        for (const Region &reg : heap) {
+            sum_acc_add(&value_acc, reg.value);
+            sum_acc_add(&error_acc, reg.error);
+        }
+        double value = sum_acc_result(value_acc), error = sum_acc_result(error_acc);
+        result.value = value;
+        result.error = error;
+        if (error <= std::max(abs_tol, rel_tol * fabs(value))) {
+            result.status = 0;
+            break;
+        }
+        if (result.evaluations + 2 * per_region > max_eval) {
+            result.status = 1;
+            break;
+        }
+
+        // 取出误差最大的一批子区域
+        long budget = (max_eval - result.evaluations) / (2 * per_region);
+        int take = (int) std::min<long>(std::min<long>(batch, (long) heap.size()), budget);
+        std::vector<Region> parents;
+        for (int k = 0; k < take; k++) {
+            std::pop_heap(heap.begin(), heap.end(), region_less);
+            parents.push_back(heap.back());
+            heap.pop_back();
+        }
+
+        std::vector<Region> children(2 * parents.size());
+        for (size_t k = 0; k < parents.size(); k++) {
+            const Region &p = parents[k];
+            double mid = 0.5 * (p.lo[p.split_dim] + p.hi[p.split_dim]);
+            children[2 * k] = p;
+            children[2 * k].hi[p.split_dim] = mid;
+            children[2 * k + 1] = p;
+            children[2 * k + 1].lo[p.split_dim] = mid;
+        }
+
+        #pragma omp parallel
+        {
+            std::vector<double> local_pts, local_vals;
+            #pragma omp for schedule(dynamic)
+            for (long k = 0; k < (long) children.size(); k++) {
+                apply_tensor_rule(f, r, dim, children[k], local_pts, local_vals);
+            }
+        }
+        result.evaluations += (long) children.size() * per_region;
+
+        // 子区域误差以各自的按维估计为准；父区域与两子区域之和的差按 Richardson 外推折算为子区域的误差
+        // （细分方向上 h 减半，误差缩小 2^order 倍）作为下限，防止差分比在个别区域偶然偏小而低估
+        double richardson = 1.0 / (std::ldexp(1.0, r.order) - 1.0);
+        for (size_t k = 0; k < parents.size(); k++) {
+            double diff = fabs(parents[k].value - children[2 * k].value - children[2 * k + 1].value);
+            for (int c = 0; c < 2; c++) {
+                Region &child = children[2 * k + c];
+                child.error = std::max(child.error, 0.5 * diff * richardson);
+                heap.push_back(std::move(child));
+                std::push_heap(heap.begin(), heap.end(), region_less);
+            }
+        }
+    }
+    return result;
+}
+
+// 随机数字移位的 Sobol 拟蒙特卡罗：n_shifts 组独立移位给出误差估计；
+// 分块部分和按块号顺序合并，结果与线程数无关
+template <class F>
+CubatureResult sobol_cubature(F f, int dim, const double *lo, const double *hi,
+                              long n_points, int n_shifts = 8, uint64_t seed = 20241119) {
+    CubatureResult result = {0.0, 0.0, 0, -1};
+    if (dim < 1 || dim > CUBATURE_MAX_SOBOL_DIM || n_points < 1 || (long long) n_points > CUBATURE_MAX_SOBOL_POINTS ||
+        n_shifts < 2) {
+        return result;
+    }
+
+    SobolSequence sobol(dim);
+    double volume = 1.0;
+    for (int d = 0; d < dim; d++) volume *= hi[d] - lo[d];
+
+    Rng rng;
+    rng_init(&rng, seed);
+    std::vector<uint32_t> shifts((size_t) n_shifts * dim);
+    for (uint32_t &s : shifts) s = (uint32_t) (rng_next(&rng) >> 32);
+
+    long n_blocks = (n_points + CUBATURE_BLOCK - 1) / CUBATURE_BLOCK;
+    std::vector<double> estimates(n_shifts);
+    std::vector<double> partial(n_blocks);
+
+    for (int s = 0; s < n_shifts; s++) {
+        const uint32_t *shift = &shifts[(size_t) s * dim];
+        #pragma omp parallel
+        {
+            std::vector<double> pts((size_t) CUBATURE_BLOCK * dim);
+            uint32_t x[CUBATURE_MAX_SOBOL_DIM];
+            #pragma omp for schedule(static)
+            for (long blk = 0; blk < n_blocks; blk++) {
+                long start = blk * CUBATURE_BLOCK;
+                int count = (int) std::min<long>(CUBATURE_BLOCK, n_points - start);
+                sobol.point((uint64_t) start, x);
+                for (int p = 0; p < count; p++) {
+                    for (int d = 0; d < dim; d++) {
+                        double u = ((double) (x[d] ^ shift[d]) + 0.5) * (1.0 / 4294967296.0);
+                        pts[(size_t) p * dim + d] = lo[d] + u * (hi[d] - lo[d]);
+                    }
+                    if (p + 1 < count) sobol.next((uint64_t) (start + p), x);  // 最后一点之后不再递推，序号不越过 2^32 - 1
+                }
+                double sum = 0.0;
+                for (int p = 0; p < count; p++) sum += f(&pts[(size_t) p * dim]);
+                partial[blk] = sum;
+            }
+        }
+        estimates[s] = volume * sum_neumaier(partial.data(), (size_t) n_blocks) / (double) n_points;
+    }
+
+    double mean = 0.0;
+    for (double e : estimates) mean += e;
+    mean /= n_shifts;
+    double var = 0.0;
+    for (double e : estimates) var += (e - mean) * (e - mean);
+    var /= (double) (n_shifts - 1);
+
+    result.value = mean;
+    result.error = sqrt(var / n_shifts);
+    result.evaluations = n_points * (long) n_shifts;
+    result.status = 0;
+    return result;
+}
+
+#endif // CUBATURE_HPP
@@ -0,0 +1,41 @@
+/***
+ * 复化辛卜生公式的变步长求积：每轮把子区间数加倍，相邻两次结果之差小于 eps 时停止
+ * @Date 2026/10/19
+ * @Author: 王春博
+ */
+#ifndef SIMPSON_H
+#define SIMPSON_H
+
+#include <math.h>
+#include "../common/sum.h"
+
+// 返回最后一次的求积结果；converged 非空时写入是否在 max_iter 轮内达到 eps
+static inline double composite_simpson(double (*f)(double), double a, double b, double eps, int max_iter,
+                                       int *converged) {
+    int n = 2;
+    double h = (b - a) / n;
+    double Tn, T2n;
+    int iter;
+    // 初始辛卜生公式计算
+    Tn = (h / 3) * (f(a) + 4 * f(a + h) + f(b));
+    for (iter = 0; iter < max_iter; iter++) {
+        SumAcc acc = sum_acc_init();  // 补偿求和，n 很大时不丢小项
+        for (int i = 0; i < n; i++) {
+            double x = a + i * h;  // 直接计算节点，避免 x += h 的误差累积
+            double mid = x + h / 2.0;
+            sum_acc_add(&acc, f(x) + 4 * f(mid) + f(x + h));
+        }
+        T2n = sum_acc_result(acc) * h / 6;
+        if (fabs(T2n - Tn) < eps) {
+            if (converged != NULL) *converged = 1;
+            return T2n;
+        }
+        n *= 2;
+        h /= 2;
+        Tn = T2n;
+    }
+    if (converged != NULL) *converged = 0;
+    return Tn;
+}
+
+#endif // SIMPSON_H
@@ -0,0 +1,75 @@
+/***
+ * 多维盒形区域求积：自适应张量积规则与 Sobol 拟蒙特卡罗
+ * @Date 2026/10/19
+ * @Author: 王春博
+ */
+#include <cstdio>
+#include <cmath>
+#include <chrono>
+#include "cubature.hpp"
+
+// 二维测试函数：sin(x)sin(y)，在 [0,π]^2 上积分为 4
+double f_sin2(const double *x) {
+    return sin(x[0]) * sin(x[1]);
+}
+
+// 三维测试函数：x^3 y^3 z^3，在 [0,1]^3 上积分为 1/64
+double f_cube3(const double *x) {
+    return x[0] * x[0] * x[0] * x[1] * x[1] * x[1] * x[2] * x[2] * x[2];
+}
+
+// 三维峰值函数：exp(-100|x-0.5|^2)，积分约为 (π/100)^(3/2)
+double f_peak3(const double *x) {
+    double r2 = 0.0;
+    for (int d = 0; d < 3; d++) r2 += (x[d] - 0.5) * (x[d] - 0.5);
+    return exp(-100 * r2);
+}
+
+// 八维测试函数：prod cos(x_d)，在 [0,1]^8 上积分为 sin(1)^8
+double f_cos8(const double *x) {
+    double p = 1.0;
+    for (int d = 0; d < 8; d++) p *= cos(x[d]);
+    return p;
+}
+
+void report(const char *name, CubatureResult r, double exact, double seconds) {
+    printf("%-28s value = %.12f  est.err = %.2e  true.err = %.2e  evals = %ld  status = %d  time = %.4f s\n",
+           name, r.value, r.error, fabs(r.value - exact), r.evaluations, r.status, seconds);
+}
+
+template <class Fn>
+double timed(Fn fn, CubatureResult &r) {
+    auto start = std::chrono::steady_clock::now();
+    r = fn();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(end - start).count();
+}
+
+int main() {
+    CubatureResult r;
+    double t;
+
+    double lo2[2] = {0, 0}, hi2[2] = {M_PI, M_PI};
+    t = timed([&] { return adaptive_cubature(f_sin2, 2, lo2, hi2, 1e-10, 1e-10, 1000000, CubatureRule::Gauss); }, r);
+    report("2D sin*sin  Gauss", r, 4.0, t);
+    t = timed([&] { return adaptive_cubature(f_sin2, 2, lo2, hi2, 1e-6, 1e-10, 1000000, CubatureRule::Simpson); }, r);
+    report("2D sin*sin  Simpson", r, 4.0, t);
+
+    double lo3[3] = {0, 0, 0}, hi3[3] = {1, 1, 1};
+    t = timed([&] { return adaptive_cubature(f_cube3, 3, lo3, hi3, 1e-12, 1e-12, 1000000); }, r);
+    report("3D x^3y^3z^3 Gauss", r, 1.0 / 64, t);
+    double peak = pow(M_PI / 100, 1.5) * pow(erf(5.0), 3);
+    t = timed([&] { return adaptive_cubature(f_peak3, 3, lo3, hi3, 1e-9, 1e-7, 5000000); }, r);
+    report("3D peak     Gauss", r, peak, t);
+    t = timed([&] { return sobol_cubature(f_peak3, 3, lo3, hi3, 1 << 16); }, r);
+    report("3D peak     Sobol", r, peak, t);
+
+    double lo8[8], hi8[8];
+    for (int d = 0; d < 8; d++) {
+        lo8[d] = 0;
+        hi8[d] = 1;
+    }
+    t = timed([&] { return sobol_cubature(f_cos8, 8, lo8, hi8, 1 << 16); }, r);
+    report("8D prod cos Sobol", r, pow(sin(1.0), 8), t);
+    return 0;
+}
@@ -0,0 +1,76 @@
+/**
+ * @Descripttion: 稠密 LU 分解（部分选主元）的 C++ 接口，按元素类型转发到 common/dense_lu.h 的 double 与 float 实现
+ * @filename: lu.hpp
+ * @Author: 王春博
+ * @Date: 2026.10.19
+ * @Version: V1.2
+ *
+ * 矩阵按行优先连续存放，A[i * lda + j]；分解就地进行，L 的单位对角线不存储。
+ * 换行只改排列向量：逻辑第 i 行存放在物理第 perm[i] 行，数据本身不移动。
+ * 分解后用 lu_condest 以 O(n^2) 代价估计 1-范数条件数，不必再做一次 O(n^3) 的检验。
+ * 这里只负责按类型选择实现并分配工作区，算法本身只在 dense_lu.h 中维护一份。
+ */
+
+#ifndef LU_HPP
+#define LU_HPP
+
+#include <vector>
+#include "../common/dense_lu.h"
+
+// 按元素类型选择 C 实现；只支持 float 与 double
+template <class T>
+struct DenseLu;
+
+template <>
+struct DenseLu<double> {
+    static constexpr auto factor = dense_lu_factor;
+    static constexpr auto solve = dense_lu_solve;
+    static constexpr auto solve_transposed = dense_lu_solve_transposed;
+    static constexpr auto norm1 = dense_lu_norm1;
+    static constexpr auto condest = dense_lu_condest;
+};
+
+template <>
+struct DenseLu<float> {
+    static constexpr auto factor = dense_lu_factor_f;
+    static constexpr auto solve = dense_lu_solve_f;
+    static constexpr auto solve_transposed = dense_lu_solve_transposed_f;
+    static constexpr auto norm1 = dense_lu_norm1_f;
+    static constexpr auto condest = dense_lu_condest_f;
+};
+
+// 就地 LU 分解：perm 为输出的行排列；growth 非空时写入主元增长因子 max|U| / max|A|
+// 成功返回 0，遇到零主元或非有限主元返回其列号 + 1
+template <class T>
+int lu_factor(T *A, int n, int lda, int *perm, double *growth = nullptr) {
+    return DenseLu<T>::factor(A, n, lda, perm, growth);
+}
+
+// 用 lu_factor 的结果求解 A x = b，b 就地替换为 x
+template <class T>
+void lu_solve(const T *LU, int n, int lda, const int *perm, T *b) {
+    std::vector<T> work(n);
+    DenseLu<T>::solve(LU, n, lda, perm, b, work.data());
+}
+
+// 求解 A^T x = b，b 就地替换为 x
+template <class T>
+void lu_solve_transposed(const T *LU, int n, int lda, const int *perm, T *b) {
+    std::vector<T> work(n);
+    DenseLu<T>::solve_transposed(LU, n, lda, perm, b, work.data());
+}
+
+// 1-范数（列和的最大值），须在分解前计算
+template <class T>
+double lu_norm1(const T *A, int n, int lda) {
+    return DenseLu<T>::norm1(A, n, lda);
+}
+
+// Hager/Higham 条件数估计：返回 kappa_1(A) 的下界估计，anorm 为分解前的 ||A||_1
+template <class T>
+double lu_condest(const T *LU, int n, int lda, const int *perm, double anorm) {
+    std::vector<T> work(DENSE_CONDEST_WORK(n));
+    return DenseLu<T>::condest(LU, n, lda, perm, anorm, work.data());
+}
+
+#endif // LU_HPP
@@ -0,0 +1,143 @@
+/**
+ * @Descripttion: 混合精度迭代精化：float 分解 + double（补偿点积）残差修正，停滞时自动退回 double 分解
+ * @filename: mixed_refine.hpp
+ * @Author: 王春博
+ * @Date: 2026.10.19
+ * @Version: V1.1
+ */
+
+#ifndef MIXED_REFINE_HPP
+#define MIXED_REFINE_HPP
+
+#include <cmath>
+#include <cfloat>
+#include <vector>
+#include "lu.hpp"
+#include "../common/sum.h"
+
+// 求解方式
+#define REFINE_MIXED 0     // float 分解 + 迭代精化收敛
+#define REFINE_FALLBACK 1  // 精化停滞或 float 分解失败，已改用 double 分解
+#define REFINE_SINGULAR 2  // double 分解也遇到零主元
+
+struct RefineOptions {
+    int max_iter = 30;          // 最大精化次数
+    double stall_ratio = 0.5;   // 修正量缩小得比这个比例慢即视为停滞
+    double max_cond = 0.1 / FLT_EPSILON;  // float 分解估计的条件数超过此值时直接退回，不再尝试精化
+};
+
+struct RefineResult {
+    int iterations;     // 精化次数
+    double residual;    // 最终 ||b - A x||_inf / (||A||_inf ||x||_inf + ||b||_inf)
+    int status;
+    double cond;        // 1-范数条件数估计
+};
+
+namespace refine_detail {
+
+inline double norm_inf(const double *v, int n) {
+    double m = 0.0;
+    for (int i = 0; i < n; i++) m = std::fmax(m, std::fabs(v[i]));
+    return m;
+}
+
+// r = b - A x，每行用补偿点积，精度高于 double
+inline void residual(const double *A, int n, int lda, const double *b, const double *x, double *r) {
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < n; i++) {
+        SumAcc acc = sum_acc_init();
+        sum_acc_add(&acc, b[i]);
+        sum_acc_add(&acc, -sum_dot(A + (long) i * lda, x, (size_t) n));
+        r[i] = sum_acc_result(acc);
+    }
+}
+
+}  // namespace refine_detail
+
+// 求解 A x = b：A 按行优先存放且不被修改
+inline RefineResult mixed_precision_solve(const double *A, int n, int lda, const double *b, double *x,
+                                          const RefineOptions &opt = RefineOptions()) {
+    using namespace refine_detail;
+    RefineResult result = {0, 0.0, REFINE_MIXED, 0.0};
+
+    double norm_a = 0.0;
+    for (int i = 0; i < n; i++) {
+        double row = 0.0;
+        for (int j = 0; j < n; j++) row += std::fabs(A[(long) i * lda + j]);
+        norm_a = std::fmax(norm_a, row);
+    }
+    double norm_b = norm_inf(b, n);
+    double tol = DBL_EPSILON * std::sqrt((double) n);
+
+    // float 分解：矩阵超出 float 范围或出现零主元时直接退回
+    std::vector<float> Af((size_t) n * n);
+    std::vector<int> perm(n);
+    bool ok = norm_a < FLT_MAX;
+    for (int i = 0; i < n && ok; i++) {
+        for (int j = 0; j < n; j++) Af[(size_t) i * n + j] = (float) A[(long) i * lda + j];
+    }
+    ok = ok && lu_factor(Af.data(), n, n, perm.data()) == 0;
+    // 条件数估计只需 O(n^2)，明显病态时精化不会收敛，省掉这些迭代
+    if (ok) {
+        result.cond = lu_condest(Af.data(), n, n, perm.data(), lu_norm1(A, n, lda));
+        ok = result.cond < opt.max_cond;
+    }
+
+    std::vector<double> r(n);
+    std::vector<float> rf(n);
+    if (ok) {
+        // 初始解
+        for (int i = 0; i < n; i++) rf[i] = (float) b[i];
+        lu_solve(Af.data(), n, n, perm.data(), rf.data());
+        for (int i = 0; i < n; i++) x[i] = rf[i];
+
+        double prev_step = INFINITY;
+        ok = false;
+        for (int iter = 1; iter <= opt.max_iter; iter++) {
+            residual(A, n, lda, b, x, r.data());
+            double norm_r = norm_inf(r.data(), n), norm_x = norm_inf(x, n);
+            result.iterations = iter - 1;
+            result.residual = norm_r / (norm_a * norm_x + norm_b);
+            if (norm_r <= tol * norm_a * norm_x) {
+                ok = true;
+                break;
+            }
+            // 残差先按范数缩放再转成 float，避免下溢
+            double scale = norm_r > 0 ? norm_r : 1.0;
+            for (int i = 0; i < n; i++) rf[i] = (float) (r[i] / scale);
+            lu_solve(Af.data(), n, n, perm.data(), rf.data());
+            double step = 0.0;
+            for (int i = 0; i < n; i++) {
+                double d = rf[i] * scale;
+                x[i] += d;
+                step = std::fmax(step, std::fabs(d));
+            }
+            if (!std::isfinite(step) || step > opt.stall_ratio * prev_step) break;
+            prev_step = step;
+        }
+        if (ok) return result;
+    }
+
+    // 退回 double 分解
+    result.status = REFINE_FALLBACK;
+    std::vector<double> Ad((size_t) n * n);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) Ad[(size_t) i * n + j] = A[(long) i * lda + j];
+    }
+    if (lu_factor(Ad.data(), n, n, perm.data()) != 0) {
+        result.status = REFINE_SINGULAR;
+        return result;
+    }
+    result.cond = lu_condest(Ad.data(), n, n, perm.data(), lu_norm1(A, n, lda));
+    for (int i = 0; i < n; i++) x[i] = b[i];
+    lu_solve(Ad.data(), n, n, perm.data(), x);
+    // double 分解后再做一次精化
+    residual(A, n, lda, b, x, r.data());
+    lu_solve(Ad.data(), n, n, perm.data(), r.data());
+    for (int i = 0; i < n; i++) x[i] += r[i];
+    residual(A, n, lda, b, x, r.data());
+    result.residual = norm_inf(r.data(), n) / (norm_a * norm_inf(x, n) + norm_b);
+    return result;
+}
+
+#endif // MIXED_REFINE_HPP
@@ -0,0 +1,377 @@
+/**
+ * @Descripttion: 外存稠密 LU 分解（部分选主元）：矩阵按块存放在文件中，跨面板左视、面板内右视的分块算法，
+ *                内存中只保留一个面板与两列块缓冲，下一列块在后台线程预读，与当前列块的计算重叠
+ * @filename: ooc_lu.hpp
+ * @Author: 王春博
+ * @Date: 2026.10.19
+ * @Version: V1.0
+ *
+ * 存储：阶数补齐到块边长 t 的倍数 np（补出的部分为单位阵），共 nt x nt 块，每块 t x t 按行连续；
+ * 块按列优先排列，块 (i, j) 位于文件第 (j * nt + i) 块，一列块在文件中连续，一次 pread 读完。
+ * 分解：列块按内存预算分组为面板（wt 列块）。处理一个面板时，先依次读入它左边的每一列块 k（只读对角块及以下），
+ * 对面板施加第 k 列块的行交换，再用 L_kk 做三角求解、用 L_ik 做块乘更新；读第 k + 1 列块与第 k 列块的计算同时进行。
+ * 之后在内存中对面板做右视分块 LU，写回文件。左视顺序下文件里的每一列块只在它所在的面板写一次。
+ * 行交换：ipiv[r] 为第 r 步与第 r 行交换的（补齐后的）全局行号。交换只作用于当时及右边的列，
+ * 第 k 列块的 L 保持第 k 步结束时的行序，求解时按列块交替施加交换与前代，与分解过程一致。
+ * 一个面板的每块要与其左边每一列块的一块相乘，读入一块 t x t 做 2 t^2 * (wt t) 次运算，面板越宽 I/O 相对越少。
+ * 仅支持 POSIX。
+ */
+
+#ifndef OOC_LU_HPP
+#define OOC_LU_HPP
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <future>
+#include <new>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include "../common/bench.h"
+
+#define OOC_DEFAULT_TILE 256      // 默认块边长
+#define OOC_PARALLEL_ROWS 4096    // 面板内消元的剩余行数不少于此值时并行
+
+// 返回值：0 成功；正数 k 表示第 k 列主元为零（矩阵奇异）
+#define OOC_IO_ERROR -1
+#define OOC_NO_MEMORY -2
+#define OOC_BAD_ARGUMENT -3  // 阶数或块边长不为正，或工作内存容不下一列块面板加两列块缓冲
+
+struct OocStats {
+    double seconds;          // 分解总耗时
+    double io_wait_seconds;  // 计算线程等待读写的时间，预读完全重叠时接近 0
+    double bytes_read;
+    double bytes_written;
+    int panels;
+    int panel_tiles;         // 每个面板的列块数
+    double memory_bytes;     // 实际占用的工作内存
+};
+
+namespace ooc_detail {
+
+inline int read_all(int fd, void *buf, size_t bytes, off_t offset) {
+    char *p = (char *) buf;
+    while (bytes > 0) {
+        ssize_t r = pread(fd, p, bytes, offset);
+        if (r < 0 && errno == EINTR) continue;
+        if (r <= 0) return -1;
+        p += r;
+        bytes -= (size_t) r;
+        offset += r;
+    }
+    return 0;
+}
+
+inline int write_all(int fd, const void *buf, size_t bytes, off_t offset) {
+    const char *p = (const char *) buf;
+    while (bytes > 0) {
+        ssize_t r = pwrite(fd, p, bytes, offset);
+        if (r < 0 && errno == EINTR) continue;
+        if (r <= 0) return -1;
+        p += r;
+        bytes -= (size_t) r;
+        offset += r;
+    }
+    return 0;
+}
+
+// B <- L^{-1} B，L 为单位下三角块，B 为 t x t 块
+inline void trsm_lower_tile(const double *L, double *B, int t) {
+    for (int i = 1; i < t; i++) {
+        double *bi = B + (size_t) i * t;
+        for (int k = 0; k < i; k++) {
+            double l = L[(size_t) i * t + k];
+            const double *bk = B + (size_t) k * t;
+            #pragma omp simd
+            for (int j = 0; j < t; j++) bi[j] -= l * bk[j];
+        }
+    }
+}
+
+// C <- C - A B，三块都是 t x t；按 i-k-j 顺序，B 整块留在二级缓存中
+inline void gemm_sub_tile(const double *A, const double *B, double *C, int t) {
+    for (int i = 0; i < t; i++) {
+        double *ci = C + (size_t) i * t;
+        for (int k = 0; k < t; k++) {
+            double a = A[(size_t) i * t + k];
+            const double *bk = B + (size_t) k * t;
+            #pragma omp simd
+            for (int j = 0; j < t; j++) ci[j] -= a * bk[j];
+        }
+    }
+}
+
+}  // namespace ooc_detail
+
+class OocLU {
+public:
+    OocLU() = default;
+    OocLU(const OocLU &) = delete;
+    OocLU &operator=(const OocLU &) = delete;
+    ~OocLU() {
+        if (fd_ >= 0) close(fd_);
+    }
+
+    // 建立 n 阶矩阵文件，entry(i, j) 给出元素；按列块生成与写入，内存占用为一列块。
+    // 成功返回 0；n 或 tile 不为正返回 OOC_BAD_ARGUMENT，此时不创建文件
+    template <class F>
+    int create(const char *path, int n, F entry, int tile = OOC_DEFAULT_TILE) {
+        if (n <= 0 || tile <= 0) return OOC_BAD_ARGUMENT;
+        if (fd_ >= 0) close(fd_);
+        n_ = n;
+        t_ = tile;
+        nt_ = (n + tile - 1) / tile;
+        np_ = nt_ * tile;
+        fd_ = open(path, O_RDWR | O_CREAT | O_TRUNC, 0600);
+        if (fd_ < 0) return OOC_IO_ERROR;
+        std::vector<double> col;
+        try {
+            col.resize((size_t) nt_ * tile_size());
+            ipiv_.assign(np_, 0);
+        } catch (const std::bad_alloc &) {
+            return OOC_NO_MEMORY;
+        }
+        for (int j = 0; j < nt_; j++) {
+            #pragma omp parallel for schedule(static)
+            for (int r = 0; r < np_; r++) {
+                double *row = col.data() + (size_t) (r / t_) * tile_size() + (size_t) (r % t_) * t_;
+                for (int c = 0; c < t_; c++) {
+                    int g = j * t_ + c;
+                    row[c] = r < n && g < n ? entry(r, g) : (r == g ? 1.0 : 0.0);
+                }
+            }
+            if (ooc_detail::write_all(fd_, col.data(), col.size() * sizeof(double), tile_offset(0, j)) != 0) {
+                return OOC_IO_ERROR;
+            }
+        }
+        return 0;
+    }
+
+    // 在 memory_bytes 的工作内存内分解；返回 0、奇异列号或 OOC_IO_ERROR / OOC_NO_MEMORY，
+    // 预算不足 min_memory_bytes()（一列块的面板加两列块缓冲）时返回 OOC_BAD_ARGUMENT，不会超出预算
+    int factor(size_t memory_bytes, OocStats *stats = nullptr) {
+        if (memory_bytes < min_memory_bytes()) return OOC_BAD_ARGUMENT;
+        OocStats st = {};
+        double t0 = bench_now();
+        size_t column = column_bytes();
+        size_t fit = memory_bytes / column;  // 面板之外还要两列块缓冲
+        int wt = (int) std::min<size_t>(nt_, fit - 2);
+        std::vector<double> panel, buf[2];
+        try {
+            panel.resize((size_t) wt * nt_ * tile_size());
+            buf[0].resize((size_t) nt_ * tile_size());
+            buf[1].resize((size_t) nt_ * tile_size());
+        } catch (const std::bad_alloc &) {
+            return OOC_NO_MEMORY;
+        }
+        st.panel_tiles = wt;
+        st.memory_bytes = (double) (wt + 2) * column;
+
+        for (int j0 = 0; j0 < nt_; j0 += wt) {
+            int w = std::min(wt, nt_ - j0);
+            double *P = panel.data();
+            double tw = bench_now();
+            if (ooc_detail::read_all(fd_, P, (size_t) w * column, tile_offset(0, j0)) != 0) return OOC_IO_ERROR;
+            st.bytes_read += (double) w * column;
+            st.io_wait_seconds += bench_now() - tw;
+
+            // 左视：依次用左边每一列块的 L 更新面板，第 k + 1 列块在后台读入
+            std::future<int> next;
+            if (j0 > 0) next = std::async(std::launch::async, [this, &buf] { return read_lower(0, buf[0].data()); });
+            for (int k = 0; k < j0; k++) {
+                tw = bench_now();
+                if (next.get() != 0) return OOC_IO_ERROR;
+                st.io_wait_seconds += bench_now() - tw;
+                st.bytes_read += (double) (nt_ - k) * tile_size() * sizeof(double);
+                const double *L = buf[k % 2].data();
+                if (k + 1 < j0) {
+                    double *dst = buf[(k + 1) % 2].data();
+                    next = std::async(std::launch::async, [this, k, dst] { return read_lower(k + 1, dst); });
+                }
+                apply_swaps(P, w, k, 0);
+                update(P, w, k, 0, [&](int i) { return L + (size_t) (i - k) * tile_size(); });
+            }
+
+            // 面板内右视分块 LU
+            for (int c = 0; c < w; c++) {
+                int k = j0 + c;
+                int info = factor_tile_column(P, w, c, k);
+                if (info != 0) return info;
+                if (c + 1 < w) {
+                    const double *L = P + (size_t) c * nt_ * tile_size();
+                    update(P, w, k, c + 1, [&](int i) { return L + (size_t) i * tile_size(); });
+                }
+            }
+
+            tw = bench_now();
+            if (ooc_detail::write_all(fd_, P, (size_t) w * column, tile_offset(0, j0)) != 0) return OOC_IO_ERROR;
+            st.bytes_written += (double) w * column;
+            st.io_wait_seconds += bench_now() - tw;
+            st.panels++;
+        }
+        st.seconds = bench_now() - t0;
+        if (stats != nullptr) *stats = st;
+        return 0;
+    }
+
+    // 用分解结果求解 nrhs 个右端项（B 中每个右端项 n 个元素连续存放），就地替换为解；
+    // 前代与回代各顺序读一遍文件，多个右端项共用一次读取。成功返回 0
+    int solve(double *B, int nrhs = 1) const {
+        std::vector<double> X, buf[2];
+        try {
+            X.assign((size_t) nrhs * np_, 0.0);
+            buf[0].resize((size_t) nt_ * tile_size());
+            buf[1].resize((size_t) nt_ * tile_size());
+        } catch (const std::bad_alloc &) {
+            return OOC_NO_MEMORY;
+        }
+        for (int r = 0; r < nrhs; r++) std::copy(B + (size_t) r * n_, B + (size_t) (r + 1) * n_, X.data() + (size_t) r * np_);
+
+        // 前代：第 k 列块的交换，单位下三角 L_kk，再消去下方各块
+        std::future<int> next = std::async(std::launch::async, [this, &buf] { return read_lower(0, buf[0].data()); });
+        for (int k = 0; k < nt_; k++) {
+            if (next.get() != 0) return OOC_IO_ERROR;
+            const double *L = buf[k % 2].data();
+            if (k + 1 < nt_) {
+                double *dst = buf[(k + 1) % 2].data();
+                next = std::async(std::launch::async, [this, k, dst] { return read_lower(k + 1, dst); });
+            }
+            #pragma omp parallel for schedule(static) if (nrhs > 1)
+            for (int r = 0; r < nrhs; r++) {
+                double *x = X.data() + (size_t) r * np_;
+                for (int q = k * t_; q < (k + 1) * t_; q++) std::swap(x[q], x[ipiv_[q]]);
+                double *xk = x + (size_t) k * t_;
+                for (int a = 1; a < t_; a++) {
+                    for (int b = 0; b < a; b++) xk[a] -= L[(size_t) a * t_ + b] * xk[b];
+                }
+                for (int i = k + 1; i < nt_; i++) matvec_sub(L + (size_t) (i - k) * tile_size(), xk, x + (size_t) i * t_);
+            }
+        }
+
+        // 回代：第 k 列块的对角块及以上，从最后一列块往前
+        next = std::async(std::launch::async, [this, &buf] { return read_upper(nt_ - 1, buf[0].data()); });
+        for (int k = nt_ - 1, s = 0; k >= 0; k--, s++) {
+            if (next.get() != 0) return OOC_IO_ERROR;
+            const double *U = buf[s % 2].data();
+            if (k > 0) {
+                double *dst = buf[(s + 1) % 2].data();
+                next = std::async(std::launch::async, [this, k, dst] { return read_upper(k - 1, dst); });
+            }
+            #pragma omp parallel for schedule(static) if (nrhs > 1)
+            for (int r = 0; r < nrhs; r++) {
+                double *x = X.data() + (size_t) r * np_;
+                double *xk = x + (size_t) k * t_;
+                const double *Ukk = U + (size_t) k * tile_size();
+                for (int a = t_ - 1; a >= 0; a--) {
+                    double v = xk[a];
+                    for (int b = a + 1; b < t_; b++) v -= Ukk[(size_t) a * t_ + b] * xk[b];
+                    xk[a] = v / Ukk[(size_t) a * t_ + a];
+                }
+                for (int i = 0; i < k; i++) matvec_sub(U + (size_t) i * tile_size(), xk, x + (size_t) i * t_);
+            }
+        }
+        for (int r = 0; r < nrhs; r++) {
+            std::copy(X.data() + (size_t) r * np_, X.data() + (size_t) r * np_ + n_, B + (size_t) r * n_);
+        }
+        return 0;
+    }
+
+    int size() const { return n_; }
+    int tile() const { return t_; }
+    size_t column_bytes() const { return (size_t) nt_ * tile_size() * sizeof(double); }
+    size_t min_memory_bytes() const { return 3 * column_bytes(); }
+
+private:
+    size_t tile_size() const { return (size_t) t_ * t_; }
+    off_t tile_offset(int i, int j) const { return (off_t) (((size_t) j * nt_ + i) * tile_size() * sizeof(double)); }
+    double *tile_at(double *P, int i, int c) const { return P + ((size_t) c * nt_ + i) * tile_size(); }
+
+    // 读第 k 列块的对角块及以下（nt - k 块，文件中连续）
+    int read_lower(int k, double *dst) const {
+        return ooc_detail::read_all(fd_, dst, (size_t) (nt_ - k) * tile_size() * sizeof(double), tile_offset(k, k));
+    }
+
+    // 读第 k 列块的对角块及以上（k + 1 块）
+    int read_upper(int k, double *dst) const {
+        return ooc_detail::read_all(fd_, dst, (size_t) (k + 1) * tile_size() * sizeof(double), tile_offset(0, k));
+    }
+
+    // y <- y - A x，A 为一块
+    void matvec_sub(const double *A, const double *x, double *y) const {
+        for (int a = 0; a < t_; a++) {
+            const double *ra = A + (size_t) a * t_;
+            double s = 0.0;
+            #pragma omp simd reduction(+:s)
+            for (int b = 0; b < t_; b++) s += ra[b] * x[b];
+            y[a] -= s;
+        }
+    }
+
+    // 交换面板第 c0 列块起各列块中的第 r、s 行
+    void swap_rows(double *P, int w, int c0, int r, int s) const {
+        if (r == s) return;
+        for (int c = c0; c < w; c++) {
+            double *x = tile_at(P, r / t_, c) + (size_t) (r % t_) * t_;
+            double *y = tile_at(P, s / t_, c) + (size_t) (s % t_) * t_;
+            std::swap_ranges(x, x + t_, y);
+        }
+    }
+
+    void apply_swaps(double *P, int w, int k, int c0) const {
+        for (int r = k * t_; r < (k + 1) * t_; r++) swap_rows(P, w, c0, r, ipiv_[r]);
+    }
+
+    // 用第 k 列块的 L（L(i) 返回块 (i, k)）更新面板第 c0 列块起的各列块：先三角求解第 k 行块，再块乘更新下方各块
+    template <class LTile>
+    void update(double *P, int w, int k, int c0, LTile L) const {
+        #pragma omp parallel for schedule(static)
+        for (int c = c0; c < w; c++) ooc_detail::trsm_lower_tile(L(k), tile_at(P, k, c), t_);
+        long cols = w - c0, pairs = (long) (nt_ - k - 1) * cols;
+        #pragma omp parallel for schedule(dynamic, 1)
+        for (long q = 0; q < pairs; q++) {
+            int i = k + 1 + (int) (q / cols), c = c0 + (int) (q % cols);
+            ooc_detail::gemm_sub_tile(L(i), tile_at(P, k, c), tile_at(P, i, c), t_);
+        }
+    }
+
+    // 面板第 c 列块（全局第 k 列块）从对角块往下的瘦高 LU，行交换作用于该列块及其右边
+    int factor_tile_column(double *P, int w, int c, int k) {
+        for (int q = 0; q < t_; q++) {
+            int r = k * t_ + q;
+            int p = r;
+            double max_abs = 0.0;
+            for (int s = r; s < np_; s++) {
+                double v = std::fabs(tile_at(P, s / t_, c)[(size_t) (s % t_) * t_ + q]);
+                if (v > max_abs) {
+                    max_abs = v;
+                    p = s;
+                }
+            }
+            if (max_abs == 0.0 || !std::isfinite(max_abs)) return r + 1;
+            ipiv_[r] = p;
+            swap_rows(P, w, c, r, p);
+            const double *pr = tile_at(P, r / t_, c) + (size_t) (r % t_) * t_;
+            double inv = 1.0 / pr[q];
+            #pragma omp parallel for schedule(static) if (np_ - r > OOC_PARALLEL_ROWS)
+            for (int s = r + 1; s < np_; s++) {
+                double *sr = tile_at(P, s / t_, c) + (size_t) (s % t_) * t_;
+                double l = sr[q] * inv;
+                sr[q] = l;
+                if (l == 0.0) continue;
+                #pragma omp simd
+                for (int j = q + 1; j < t_; j++) sr[j] -= l * pr[j];
+            }
+        }
+        return 0;
+    }
+
+    int fd_ = -1;
+    int n_ = 0;
+    int t_ = OOC_DEFAULT_TILE;
+    int nt_ = 0;
+    int np_ = 0;
+    std::vector<int> ipiv_;
+};
+
+#endif // OOC_LU_HPP
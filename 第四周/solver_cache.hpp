@@ -0,0 +1,127 @@
+/**
+ * @Descripttion: LU 分解缓存：以矩阵内容的 128 位指纹为键，按最近最少使用淘汰，批量右端项并行回代
+ * @filename: solver_cache.hpp
+ * @Author: 王春博
+ * @Date: 2026.10.19
+ * @Version: V1.0
+ *
+ * 同一矩阵再次求解时只需 O(n^2) 算指纹与 O(n^2) 回代，省去 O(n^3) 的分解。
+ * 指纹按 8 字节字逐个混合，两路独立的乘法散列合成 128 位，连同阶数一起作键，碰撞概率可忽略。
+ */
+
+#ifndef SOLVER_CACHE_HPP
+#define SOLVER_CACHE_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <list>
+#include <new>
+#include <unordered_map>
+#include <vector>
+#include "lu.hpp"
+#include "../common/bench.h"
+
+#define SOLVER_CACHE_PARALLEL_RHS 4  // 右端项不少于此数时并行回代
+
+struct MatrixKey {
+    uint64_t h[2];
+    int n;
+
+    bool operator==(const MatrixKey &o) const { return h[0] == o.h[0] && h[1] == o.h[1] && n == o.n; }
+};
+
+struct MatrixKeyHash {
+    size_t operator()(const MatrixKey &k) const { return (size_t) (k.h[0] ^ (k.h[1] * 0x9E3779B97F4A7C15ull)); }
+};
+
+// 矩阵内容指纹：按位比较，-0.0 与 0.0 视为不同
+inline MatrixKey matrix_fingerprint(const double *A, int n) {
+    uint64_t h1 = 0x243F6A8885A308D3ull ^ (uint64_t) n, h2 = 0x13198A2E03707344ull + (uint64_t) n;
+    size_t count = (size_t) n * n;
+    for (size_t i = 0; i < count; i++) {
+        uint64_t w;
+        std::memcpy(&w, &A[i], sizeof(w));
+        h1 = (h1 ^ w) * 0x9E3779B97F4A7C15ull;
+        h1 ^= h1 >> 32;
+        h2 = (h2 + w) * 0xC2B2AE3D27D4EB4Full;
+        h2 ^= h2 >> 29;
+    }
+    return {{h1, h2}, n};
+}
+
+struct CachedFactor {
+    MatrixKey key;
+    std::vector<double> lu;
+    std::vector<int> perm;
+    int info;  // lu_factor 的返回值，非 0 表示奇异
+    size_t bytes() const { return lu.size() * sizeof(double) + perm.size() * sizeof(int); }
+};
+
+class FactorCache {
+public:
+    explicit FactorCache(size_t max_bytes) : max_bytes_(max_bytes) {}
+
+    // 查找；命中时移到最近使用的位置
+    const CachedFactor *find(const MatrixKey &key) {
+        auto it = index_.find(key);
+        if (it == index_.end()) return nullptr;
+        lru_.splice(lru_.begin(), lru_, it->second);
+        hits_++;
+        return &*it->second;
+    }
+
+    // 分解 A 并放入缓存，必要时淘汰最久未用的分解；seconds 非空时写入分解耗时。
+    // 单个分解超过缓存上限或内存不足返回 nullptr，此时不淘汰任何已有分解
+    const CachedFactor *insert(const MatrixKey &key, const double *A, double *seconds = nullptr) {
+        misses_++;
+        int n = key.n;
+        size_t need = (size_t) n * n * sizeof(double) + (size_t) n * sizeof(int);
+        if (need > max_bytes_) return nullptr;
+        CachedFactor f;
+        f.key = key;
+        try {
+            f.lu.assign(A, A + (size_t) n * n);
+            f.perm.resize(n);
+        } catch (const std::bad_alloc &) {
+            return nullptr;
+        }
+        double t0 = bench_now();
+        f.info = lu_factor(f.lu.data(), n, n, f.perm.data());
+        if (seconds != nullptr) *seconds = bench_now() - t0;
+        while (!lru_.empty() && bytes_ + need > max_bytes_) evict();
+        bytes_ += need;
+        lru_.push_front(std::move(f));
+        index_[key] = lru_.begin();
+        return &lru_.front();
+    }
+
+    long hits() const { return hits_; }
+    long misses() const { return misses_; }
+    long entries() const { return (long) lru_.size(); }
+    size_t bytes() const { return bytes_; }
+
+private:
+    void evict() {
+        bytes_ -= lru_.back().bytes();
+        index_.erase(lru_.back().key);
+        lru_.pop_back();
+    }
+
+    size_t max_bytes_;
+    size_t bytes_ = 0;
+    long hits_ = 0;
+    long misses_ = 0;
+    std::list<CachedFactor> lru_;  // 表头为最近使用
+    std::unordered_map<MatrixKey, std::list<CachedFactor>::iterator, MatrixKeyHash> index_;
+};
+
+// 用缓存的分解就地求解 nrhs 个右端项（B 中每个右端项 n 个元素连续存放）；奇异时返回 info
+inline int factor_solve(const CachedFactor &f, double *B, int nrhs) {
+    if (f.info != 0) return f.info;
+    int n = f.key.n;
+    #pragma omp parallel for schedule(static) if (nrhs >= SOLVER_CACHE_PARALLEL_RHS)
+    for (int r = 0; r < nrhs; r++) lu_solve(f.lu.data(), n, n, f.perm.data(), B + (size_t) r * n);
+    return 0;
+}
+
+#endif // SOLVER_CACHE_HPP
@@ -0,0 +1,173 @@
+/**
+ * @Descripttion: 求解服务的通信协议与客户端函数：Unix 域套接字传请求头，矩阵与右端项放在共享内存里随请求传递文件描述符
+ * @filename: solver_protocol.h
+ * @Author: 王春博
+ * @Date: 2026.10.19
+ * @Version: V1.0
+ *
+ * 一次请求 = 一个 SolverRequest + （可选）一个共享内存文件描述符（SCM_RIGHTS）。共享内存布局：
+ *   SOLVER_OP_SOLVE：       A（n x n，按行）紧接 B（nrhs 个右端项，每个 n 个元素连续存放）
+ *   SOLVER_OP_SOLVE_CACHED：只有 B，矩阵由上次回复中的 key 指定
+ * 服务端把解就地写回 B 所在的共享内存，套接字上只回一个 SolverReply，矩阵和解都不经过套接字复制。
+ * 仅支持 POSIX；C 与 C++ 均可直接包含。
+ */
+
+#ifndef SOLVER_PROTOCOL_H
+#define SOLVER_PROTOCOL_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#define SOLVER_MAGIC 0x4E534F4Cu                        // "NSOL"
+#define SOLVER_DEFAULT_SOCKET "/tmp/numeric_solver.sock"
+
+// 请求类型
+#define SOLVER_OP_SOLVE 1         // 带矩阵求解：命中缓存则直接回代，否则先分解并缓存
+#define SOLVER_OP_SOLVE_CACHED 2  // 只带右端项，按 key 查缓存
+#define SOLVER_OP_STATS 3         // 查询缓存统计
+#define SOLVER_OP_SHUTDOWN 4      // 关闭服务
+
+// 回复状态：0 成功；正数 k 表示第 k 列主元为零（矩阵奇异）
+#define SOLVER_OK 0
+#define SOLVER_BAD_REQUEST -1     // 参数或共享内存大小不符
+#define SOLVER_NOT_CACHED -2      // SOLVE_CACHED 的 key 不在缓存中（未分解过或已被淘汰）
+#define SOLVER_NO_MEMORY -3
+
+typedef struct {
+    uint32_t magic;
+    uint32_t op;
+    int32_t n;
+    int32_t nrhs;
+    uint64_t key[2];  // SOLVE_CACHED 时使用
+} SolverRequest;
+
+typedef struct {
+    int32_t status;
+    int32_t cached;          // 1 表示命中缓存，未重新分解
+    uint64_t key[2];         // 矩阵内容的 128 位指纹，之后可用 SOLVE_CACHED 只发右端项
+    double factor_seconds;   // 本次分解耗时（命中缓存时为 0）
+    double solve_seconds;    // 本次回代耗时
+    int64_t hits;
+    int64_t misses;
+    int64_t entries;         // 缓存中的分解个数
+    int64_t bytes;           // 缓存占用字节数
+} SolverReply;
+
+// 发送一段数据并附带文件描述符（fd < 0 时不附带）；成功返回 0
+static inline int solver_send(int sock, const void *data, size_t size, int fd) {
+    struct iovec iov;
+    struct msghdr msg;
+    char control[CMSG_SPACE(sizeof(int))];
+    memset(&msg, 0, sizeof(msg));
+    iov.iov_base = (void *) data;
+    iov.iov_len = size;
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    if (fd >= 0) {
+        memset(control, 0, sizeof(control));
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
+        struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type = SCM_RIGHTS;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+        memcpy(CMSG_DATA(cmsg), &fd, sizeof(int));
+    }
+    return sendmsg(sock, &msg, 0) == (ssize_t) size ? 0 : -1;
+}
+
+// 接收一段定长数据，附带的文件描述符写入 *fd（没有时为 -1）；对端关闭返回 1，出错返回 -1
+static inline int solver_recv(int sock, void *data, size_t size, int *fd) {
+    struct iovec iov;
+    struct msghdr msg;
+    char control[CMSG_SPACE(sizeof(int))];
+    memset(&msg, 0, sizeof(msg));
+    iov.iov_base = data;
+    iov.iov_len = size;
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+    if (fd != NULL) *fd = -1;
+    ssize_t got = recvmsg(sock, &msg, MSG_WAITALL);
+    if (got == 0) return 1;
+    if (got != (ssize_t) size) return -1;
+    for (struct cmsghdr *c = CMSG_FIRSTHDR(&msg); c != NULL; c = CMSG_NXTHDR(&msg, c)) {
+        if (c->cmsg_level == SOL_SOCKET && c->cmsg_type == SCM_RIGHTS) {
+            int received;
+            memcpy(&received, CMSG_DATA(c), sizeof(int));
+            if (fd != NULL) *fd = received; else close(received);
+        }
+    }
+    return 0;
+}
+
+// 连接服务，失败返回 -1
+static inline int solver_connect(const char *path) {
+    struct sockaddr_un addr;
+    if (strlen(path) >= sizeof(addr.sun_path)) return -1;
+    int sock = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (sock < 0) return -1;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, path);
+    if (connect(sock, (struct sockaddr *) &addr, sizeof(addr)) != 0) {
+        close(sock);
+        return -1;
+    }
+    return sock;
+}
+
+// 匿名共享内存：在本进程映射，文件描述符随请求发给服务端
+typedef struct {
+    int fd;
+    double *data;
+    size_t bytes;
+} SolverBuffer;
+
+// 分配 count 个 double 的共享内存；成功返回 0
+static inline int solver_buffer_create(SolverBuffer *buf, size_t count) {
+    char name[64];
+    static unsigned serial = 0;
+    buf->bytes = count * sizeof(double);
+    buf->data = NULL;
+    // shm_open 后立即 unlink：只留文件描述符，进程退出即释放
+    snprintf(name, sizeof(name), "/numeric_solver_%ld_%u", (long) getpid(), serial++);
+    buf->fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (buf->fd < 0) return -1;
+    shm_unlink(name);
+    if (ftruncate(buf->fd, (off_t) buf->bytes) != 0) {
+        close(buf->fd);
+        return -1;
+    }
+    void *p = mmap(NULL, buf->bytes, PROT_READ | PROT_WRITE, MAP_SHARED, buf->fd, 0);
+    if (p == MAP_FAILED) {
+        close(buf->fd);
+        return -1;
+    }
+    buf->data = (double *) p;
+    return 0;
+}
+
+static inline void solver_buffer_free(SolverBuffer *buf) {
+    if (buf->data != NULL) munmap(buf->data, buf->bytes);
+    if (buf->fd >= 0) close(buf->fd);
+    buf->data = NULL;
+    buf->fd = -1;
+}
+
+// 发送请求并等待回复；buf 可为 NULL（STATS / SHUTDOWN）。通信失败返回 -1，否则返回 reply->status
+static inline int solver_call(int sock, const SolverRequest *req, const SolverBuffer *buf, SolverReply *reply) {
+    if (solver_send(sock, req, sizeof(*req), buf != NULL ? buf->fd : -1) != 0) return -1;
+    if (solver_recv(sock, reply, sizeof(*reply), NULL) != 0) return -1;
+    return reply->status;
+}
+
+#endif // SOLVER_PROTOCOL_H
@@ -0,0 +1,118 @@
+/**
+ * @Descripttion: 常驻求解服务：Unix 域套接字接收请求，按矩阵指纹缓存 LU 分解，右端项与解经共享内存传递
+ * @filename: 求解服务.cpp
+ * @Author: 王春博
+ * @Date: 2026.10.19
+ * @Version: V1.0
+ *
+ * 用法：求解服务 [套接字路径] [缓存上限 MB]，默认 /tmp/numeric_solver.sock、512 MB。
+ * 客户端见 solver_protocol.h；第四周的高斯消去程序加 --server 参数即通过本服务求解。
+ * 连接逐个处理，一个连接上可以连续发多个请求；分解与批量回代内部用 OpenMP 并行。
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <csignal>
+#include <sys/stat.h>
+#include "solver_protocol.h"
+#include "solver_cache.hpp"
+
+#define DEFAULT_CACHE_MB 512
+
+static void fill_stats(const FactorCache &cache, SolverReply *reply) {
+    reply->hits = cache.hits();
+    reply->misses = cache.misses();
+    reply->entries = cache.entries();
+    reply->bytes = (int64_t) cache.bytes();
+}
+
+// 映射客户端的共享内存，大小不符返回 nullptr
+static double *map_buffer(int fd, size_t bytes) {
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0 || (size_t) st.st_size < bytes) return nullptr;
+    void *p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    return p == MAP_FAILED ? nullptr : (double *) p;
+}
+
+// 处理一个请求，返回 false 表示要关闭服务
+static bool handle(FactorCache &cache, const SolverRequest &req, int fd, SolverReply *reply) {
+    memset(reply, 0, sizeof(*reply));
+    reply->status = SOLVER_BAD_REQUEST;
+    if (req.magic != SOLVER_MAGIC) return true;
+    if (req.op == SOLVER_OP_STATS || req.op == SOLVER_OP_SHUTDOWN) {
+        reply->status = SOLVER_OK;
+        fill_stats(cache, reply);
+        return req.op != SOLVER_OP_SHUTDOWN;
+    }
+    if (req.n < 1 || req.nrhs < 0 || (req.op != SOLVER_OP_SOLVE && req.op != SOLVER_OP_SOLVE_CACHED)) return true;
+
+    size_t n = (size_t) req.n, matrix = req.op == SOLVER_OP_SOLVE ? n * n : 0;
+    size_t bytes = (matrix + n * req.nrhs) * sizeof(double);
+    double *data = map_buffer(fd, bytes);
+    if (data == nullptr) return true;
+
+    const CachedFactor *f;
+    if (req.op == SOLVER_OP_SOLVE) {
+        MatrixKey key = matrix_fingerprint(data, req.n);
+        f = cache.find(key);
+        reply->cached = f != nullptr;
+        if (f == nullptr) f = cache.insert(key, data, &reply->factor_seconds);
+    } else {
+        f = cache.find({{req.key[0], req.key[1]}, req.n});
+        reply->cached = f != nullptr;
+    }
+    if (f == nullptr) {
+        reply->status = req.op == SOLVER_OP_SOLVE ? SOLVER_NO_MEMORY : SOLVER_NOT_CACHED;
+    } else {
+        double t0 = bench_now();
+        reply->status = factor_solve(*f, data + matrix, req.nrhs);  // 解就地写回共享内存
+        reply->solve_seconds = bench_now() - t0;
+        reply->key[0] = f->key.h[0];
+        reply->key[1] = f->key.h[1];
+    }
+    fill_stats(cache, reply);
+    munmap(data, bytes);
+    return true;
+}
+
+int main(int argc, char *argv[]) {
+    const char *path = argc > 1 ? argv[1] : SOLVER_DEFAULT_SOCKET;
+    size_t cache_mb = argc > 2 ? strtoul(argv[2], nullptr, 10) : DEFAULT_CACHE_MB;
+    signal(SIGPIPE, SIG_IGN);  // 客户端中途退出时不终止服务
+
+    int server = socket(AF_UNIX, SOCK_STREAM, 0);
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (server < 0 || strlen(path) >= sizeof(addr.sun_path)) {
+        perror("socket");
+        return 1;
+    }
+    strcpy(addr.sun_path, path);
+    unlink(path);
+    if (bind(server, (struct sockaddr *) &addr, sizeof(addr)) != 0 || listen(server, 16) != 0) {
+        perror(path);
+        return 1;
+    }
+    fprintf(stderr, "求解服务: 监听 %s，缓存上限 %zu MB\n", path, cache_mb);
+
+    FactorCache cache(cache_mb << 20);
+    bool running = true;
+    while (running) {
+        int client = accept(server, nullptr, nullptr);
+        if (client < 0) continue;
+        SolverRequest req;
+        int fd;
+        while (running && solver_recv(client, &req, sizeof(req), &fd) == 0) {
+            SolverReply reply;
+            running = handle(cache, req, fd, &reply);
+            if (fd >= 0) close(fd);
+            if (solver_send(client, &reply, sizeof(reply), -1) != 0) break;
+        }
+        close(client);
+    }
+    close(server);
+    unlink(path);
+    fprintf(stderr, "求解服务: 已关闭（命中 %ld 次，分解 %ld 次）\n", cache.hits(), cache.misses());
+    return 0;
+}
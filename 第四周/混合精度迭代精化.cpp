@@ -0,0 +1,85 @@
+//  Author: 王春博
+//  Date: 2026/10/19
+//  Description: 混合精度迭代精化：float 分解 + double 残差修正，与纯 double LU 比较速度与精度，并演示病态矩阵的自动退回
+
+#include<iostream>
+#include<iomanip>
+#include<chrono>
+#include<vector>
+#include<cmath>
+#include "lu.hpp"
+#include "mixed_refine.hpp"
+#include "../common/rng.h"
+
+#define N 1500
+#define SEED 20241015
+
+// 对角占优的随机稠密矩阵（良态）
+void generate_matrix(std::vector<double> &A, std::vector<double> &b, int n, unsigned long long seed) {
+    Rng rng;
+    rng_init(&rng, seed);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) A[(size_t) i * n + j] = rng_uniform_range(&rng, -1, 1);
+        A[(size_t) i * n + i] += n / 4.0;
+        b[i] = rng_uniform_range(&rng, -1, 1);
+    }
+}
+
+// Hilbert 矩阵：条件数远超 1/eps(float)，精化必然停滞
+void generate_hilbert(std::vector<double> &A, std::vector<double> &b, int n) {
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) A[(size_t) i * n + j] = 1.0 / (i + j + 1);
+        b[i] = 1.0;
+    }
+}
+
+double relative_residual(const std::vector<double> &A, const std::vector<double> &b, const std::vector<double> &x, int n) {
+    double r_max = 0.0, a_max = 0.0, x_max = 0.0;
+    for (int i = 0; i < n; i++) {
+        double s = b[i], row = 0.0;
+        for (int j = 0; j < n; j++) {
+            s -= A[(size_t) i * n + j] * x[j];
+            row += std::fabs(A[(size_t) i * n + j]);
+        }
+        r_max = std::max(r_max, std::fabs(s));
+        a_max = std::max(a_max, row);
+        x_max = std::max(x_max, std::fabs(x[i]));
+    }
+    return r_max / (a_max * x_max);
+}
+
+int main() {
+    std::vector<double> A((size_t) N * N), b(N), x(N);
+    generate_matrix(A, b, N, SEED);
+
+    // 纯 double LU
+    auto start = std::chrono::steady_clock::now();
+    std::vector<double> LU(A);
+    std::vector<int> perm(N);
+    double growth = 0.0;
+    lu_factor(LU.data(), N, N, perm.data(), &growth);
+    x = b;
+    lu_solve(LU.data(), N, N, perm.data(), x.data());
+    double t_double = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << std::scientific << std::setprecision(3);
+    std::cout << "double LU:   time " << t_double << " s, residual " << relative_residual(A, b, x, N)
+              << ", growth " << growth << ", cond " << lu_condest(LU.data(), N, N, perm.data(), lu_norm1(A.data(), N, N)) << std::endl;
+
+    // 混合精度
+    start = std::chrono::steady_clock::now();
+    RefineResult res = mixed_precision_solve(A.data(), N, N, b.data(), x.data());
+    double t_mixed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "mixed IR:    time " << t_mixed << " s, residual " << relative_residual(A, b, x, N)
+              << ", iterations " << res.iterations << ", status " << res.status << ", cond " << res.cond << std::endl;
+    std::cout << std::fixed << std::setprecision(2) << "speedup " << t_double / t_mixed << "x" << std::endl;
+
+    // 病态矩阵：精化停滞，自动退回 double 分解
+    const int n = 12;
+    std::vector<double> H((size_t) n * n), h(n), y(n);
+    generate_hilbert(H, h, n);
+    res = mixed_precision_solve(H.data(), n, n, h.data(), y.data());
+    std::cout << std::scientific << std::setprecision(3);
+    std::cout << "Hilbert(" << n << "): residual " << res.residual << ", iterations " << res.iterations
+              << ", status " << res.status << ", cond " << res.cond << (res.status == REFINE_FALLBACK ? " (fallback to double)" : "") << std::endl;
+    return 0;
+}
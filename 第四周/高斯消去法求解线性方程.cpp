@@ -5,57 +5,39 @@
  */
 
 #include<cstdio>
-#include<algorithm>
-
-double augmented_matrix[101][101]; // 增广矩阵
+#include<cfloat>
+#include<vector>
+#include "lu.hpp"
 
 int main() {
     int n;
     scanf("%d", &n);
 
-    // 读取系数
-    for(int i = 0; i < n; i++) {
-        for(int j = 0; j < n + 1; j++) {
-            scanf("%lf", &augmented_matrix[i][j]);
-        }
-    }
-
-    // 高斯消去法
+    // 读取增广矩阵，系数矩阵按行连续存放
+    std::vector<double> A((size_t) n * n), b(n);
     for(int i = 0; i < n; i++) {
-        // 如果主元为 0，交换行
-        if (augmented_matrix[i][i] == 0) {
-            for (int k = i + 1; k < n; k++) {
-                if (augmented_matrix[k][i] != 0) {
-                    for (int j = 0; j <= n; j++) {
-                        std::swap(augmented_matrix[i][j], augmented_matrix[k][j]);
-                    }
-                    break;
-                }
-            }
-        }
-
-        for(int j = i + 1; j < n; j++) {
-            double rate = augmented_matrix[j][i] / augmented_matrix[i][i];
-            for(int k = i; k <= n; k++) {
-                augmented_matrix[j][k] -= rate * augmented_matrix[i][k];
-            }
+        for(int j = 0; j < n; j++) {
+            scanf("%lf", &A[(size_t) i * n + j]);
         }
+        scanf("%lf", &b[i]);
     }
 
-    // 回代
-    double x[100];
-    for(int i = n - 1; i >= 0; i--) {
-        x[i] = augmented_matrix[i][n];
-        for(int j = i + 1; j < n; j++) {
-            x[i] -= augmented_matrix[i][j] * x[j];
-        }
-        x[i] /= augmented_matrix[i][i];
+    // 高斯消去法（部分选主元，换行只改排列向量）
+    double anorm = lu_norm1(A.data(), n, n), growth = 0.0;
+    std::vector<int> perm(n);
+    if (lu_factor(A.data(), n, n, perm.data(), &growth) != 0) {
+        printf("矩阵奇异\n");
+        return 0;
     }
+    std::vector<double> x(b);
+    lu_solve(A.data(), n, n, perm.data(), x.data());
 
     // 输出结果
     for(int i = 0; i < n; i++) {
         printf("x%d = %lf\n", i + 1, x[i]);
     }
+    double cond = lu_condest(A.data(), n, n, perm.data(), anorm);
+    printf("增长因子 %.3e, 条件数估计 %.3e, 相对误差界约 %.3e\n", growth, cond, cond * growth * DBL_EPSILON);
 
     return 0;
 }